@@ -0,0 +1,455 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "attach.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "util.h"
+
+namespace lwcli { namespace attach
+{
+  namespace
+  {
+    constexpr const char detach_key = 0x1c; // Ctrl-backslash
+
+    enum class message : std::uint8_t { input = 0, resize, redraw };
+
+    //! Fixed size so that the session can read whole packets
+    struct packet
+    {
+      message type;
+      std::uint8_t length;
+      char data[30];
+    };
+    static_assert(sizeof(winsize) <= sizeof(packet::data));
+
+    volatile std::sig_atomic_t resized = 0;
+
+    void on_resize(int)
+    {
+      resized = 1;
+    }
+
+    sockaddr_un make_address(const std::string& path)
+    {
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      if (sizeof(address.sun_path) <= path.size())
+        throw std::runtime_error{"socket path too long"};
+      std::memcpy(address.sun_path, path.data(), path.size());
+      return address;
+    }
+
+    int connect_unix(const std::string& path)
+    {
+      const sockaddr_un address = make_address(path);
+      const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+        throw std::runtime_error{std::string{"socket: "} + std::strerror(errno)};
+      if (::connect(fd, reinterpret_cast<const sockaddr*>(std::addressof(address)), sizeof(address)) != 0)
+      {
+        ::close(fd);
+        return -1;
+      }
+      return fd;
+    }
+
+    int listen_unix(const std::string& path)
+    {
+      const sockaddr_un address = make_address(path);
+      const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+        throw std::runtime_error{std::string{"socket: "} + std::strerror(errno)};
+
+      if (!unlink_socket(path)) // stale socket from a dead session
+      {
+        ::close(fd);
+        throw std::runtime_error{path + ": path exists and is not a socket"};
+      }
+      // owner only, attaching gives full control of the wallet
+      const mode_t mask = ::umask(077);
+      const int bound = ::bind(fd, reinterpret_cast<const sockaddr*>(std::addressof(address)), sizeof(address));
+      const int bind_error = errno;
+      ::umask(mask);
+      if (bound != 0 || ::listen(fd, SOMAXCONN) != 0)
+      {
+        const int error = bound != 0 ? bind_error : errno;
+        ::close(fd);
+        throw std::runtime_error{"bind/listen " + path + ": " + std::strerror(error)};
+      }
+      return fd;
+    }
+
+    bool write_all(const int fd, const void* data, std::size_t length)
+    {
+      const char* bytes = static_cast<const char*>(data);
+      while (length)
+      {
+        const ssize_t written = ::write(fd, bytes, length);
+        if (written < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return false;
+        }
+        bytes += written;
+        length -= std::size_t(written);
+      }
+      return true;
+    }
+
+    winsize get_size(const int fd) noexcept
+    {
+      winsize size{};
+      if (::ioctl(fd, TIOCGWINSZ, &size) != 0 || !size.ws_row || !size.ws_col)
+      {
+        size.ws_row = 24;
+        size.ws_col = 80;
+      }
+      return size;
+    }
+
+    packet make_size(const message type, const winsize& size) noexcept
+    {
+      packet out{};
+      out.type = type;
+      out.length = sizeof(size);
+      std::memcpy(out.data, std::addressof(size), sizeof(size));
+      return out;
+    }
+
+    //! Non-blocking attached terminal, with the packet read so far
+    struct client
+    {
+      int fd;
+      std::size_t have;
+      packet in;
+    };
+
+    //! \return False if client should be dropped.
+    bool send_client(const int client, const char* data, const std::size_t length)
+    {
+      // a client that cannot keep up is dropped rather than stalling the session
+      ssize_t sent = 0;
+      do
+      {
+        sent = ::send(client, data, length, MSG_NOSIGNAL);
+      } while (sent < 0 && errno == EINTR);
+      return sent == ssize_t(length);
+    }
+
+    //! \return False if client should be dropped.
+    bool on_client(client& from, const int pty, const pid_t child)
+    {
+      char* const bytes = reinterpret_cast<char*>(std::addressof(from.in));
+      const ssize_t read = ::recv(from.fd, bytes + from.have, sizeof(from.in) - from.have, 0);
+      if (read < 0)
+        return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+      if (read == 0)
+        return false;
+
+      from.have += std::size_t(read);
+      if (from.have < sizeof(from.in))
+        return true; // rest of the packet is still in flight
+
+      const packet in = from.in;
+      from.have = 0;
+      if (sizeof(in.data) < in.length)
+        return false;
+
+      switch (in.type)
+      {
+        case message::input:
+          return write_all(pty, in.data, in.length);
+        case message::resize:
+        case message::redraw:
+        {
+          winsize size{};
+          std::memcpy(std::addressof(size), in.data, sizeof(size));
+          ::ioctl(pty, TIOCSWINSZ, &size);
+          if (in.type == message::redraw)
+            ::kill(child, SIGWINCH); // full frame for the new client
+          return true;
+        }
+        default:
+          break;
+      }
+      return false;
+    }
+
+    //! Runs in the detached session process, never returns.
+    [[noreturn]] void run_session(const std::string& path, const int listener, const char* const argv[], winsize size)
+    {
+      int pty = -1;
+      const pid_t child = ::forkpty(&pty, nullptr, nullptr, &size);
+      if (child < 0)
+        std::_Exit(EXIT_FAILURE);
+      if (child == 0)
+      {
+        ::close(listener);
+        ::execv("/proc/self/exe", const_cast<char* const*>(argv));
+        std::_Exit(127);
+      }
+
+      std::vector<client> clients;
+      std::vector<int> dropped;
+      std::vector<pollfd> fds;
+      char buffer[4096];
+      for (bool running = true; running; )
+      {
+        fds.clear();
+        fds.push_back({pty, POLLIN, 0});
+        fds.push_back({listener, POLLIN, 0});
+        for (const client& each : clients)
+          fds.push_back({each.fd, POLLIN, 0});
+
+        if (::poll(fds.data(), fds.size(), -1) < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          break;
+        }
+
+        if (fds[0].revents)
+        {
+          const ssize_t read = ::read(pty, buffer, sizeof(buffer));
+          if (read < 0 && errno == EINTR)
+            continue;
+          if (read <= 0)
+            break; // child exited
+
+          // output while nobody is attached is dropped, attach forces a redraw
+          for (const client& each : clients)
+          {
+            if (!send_client(each.fd, buffer, std::size_t(read)))
+              dropped.push_back(each.fd);
+          }
+        }
+
+        // `fds` and `clients` match from index 2, nothing was added or removed yet
+        for (std::size_t i = 2; i < fds.size(); ++i)
+        {
+          if (fds[i].revents && !on_client(clients[i - 2], pty, child))
+            dropped.push_back(fds[i].fd);
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+          const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+          if (0 <= fd)
+            clients.push_back({fd, 0, packet{}});
+        }
+
+        for (const int fd : dropped)
+        {
+          const auto match = std::find_if(clients.begin(), clients.end(), [fd] (const client& each) { return each.fd == fd; });
+          if (match != clients.end())
+          {
+            ::close(fd);
+            clients.erase(match);
+          }
+        }
+        dropped.clear();
+      }
+
+      unlink_socket(path);
+      for (const client& each : clients)
+        ::close(each.fd);
+      ::close(listener);
+      ::close(pty);
+      ::waitpid(child, nullptr, 0);
+      std::_Exit(EXIT_SUCCESS);
+    }
+
+    void start_session(const std::string& path, const char* const argv[])
+    {
+      const winsize size = get_size(STDIN_FILENO);
+
+      // listen before fork, so the first attach cannot race the session
+      const int listener = listen_unix(path);
+      const pid_t pid = ::fork();
+      if (pid < 0)
+      {
+        ::close(listener);
+        throw std::runtime_error{std::string{"fork: "} + std::strerror(errno)};
+      }
+      if (pid == 0)
+      {
+        ::setsid();
+        const int null = ::open("/dev/null", O_RDWR);
+        if (0 <= null)
+        {
+          ::dup2(null, STDIN_FILENO);
+          ::dup2(null, STDOUT_FILENO);
+          ::dup2(null, STDERR_FILENO);
+          if (STDERR_FILENO < null)
+            ::close(null);
+        }
+        run_session(path, listener, argv, size);
+      }
+      ::close(listener);
+    }
+
+    struct raw_terminal
+    {
+      termios original;
+      bool active;
+
+      raw_terminal()
+        : original{}, active(false)
+      {
+        if (::isatty(STDIN_FILENO) && ::tcgetattr(STDIN_FILENO, &original) == 0)
+        {
+          termios raw = original;
+          ::cfmakeraw(&raw);
+          active = ::tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+        }
+      }
+
+      ~raw_terminal() noexcept
+      {
+        if (active)
+          ::tcsetattr(STDIN_FILENO, TCSANOW, &original);
+      }
+    };
+
+    int relay(const int server)
+    {
+      struct sigaction action{};
+      action.sa_handler = on_resize; // no SA_RESTART, poll must wake
+      ::sigaction(SIGWINCH, &action, nullptr);
+
+      bool ended = false;
+      {
+        const raw_terminal terminal{};
+        packet out = make_size(message::redraw, get_size(STDIN_FILENO));
+        if (!write_all(server, &out, sizeof(out)))
+          return EXIT_FAILURE;
+
+        char buffer[4096];
+        for (bool running = true; running; )
+        {
+          if (resized)
+          {
+            resized = 0;
+            out = make_size(message::resize, get_size(STDIN_FILENO));
+            if (!write_all(server, &out, sizeof(out)))
+              break;
+          }
+
+          pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {server, POLLIN, 0}};
+          if (::poll(fds, 2, -1) < 0)
+          {
+            if (errno == EINTR)
+              continue;
+            break;
+          }
+
+          if (fds[1].revents)
+          {
+            const ssize_t read = ::read(server, buffer, sizeof(buffer));
+            if (read < 0 && errno == EINTR)
+              continue;
+            if (read <= 0)
+            {
+              ended = true;
+              break;
+            }
+            if (!write_all(STDOUT_FILENO, buffer, std::size_t(read)))
+              break;
+          }
+
+          if (fds[0].revents)
+          {
+            const ssize_t read = ::read(STDIN_FILENO, buffer, sizeof(out.data));
+            if (read <= 0)
+              break;
+
+            char const* const end = buffer + read;
+            char const* const key = std::find(static_cast<const char*>(buffer), end, detach_key);
+            out = packet{};
+            out.type = message::input;
+            out.length = std::uint8_t(key - buffer);
+            std::memcpy(out.data, buffer, out.length);
+            if ((out.length && !write_all(server, &out, sizeof(out))) || key != end)
+              running = false;
+          }
+        }
+      }
+
+      ::close(server);
+      std::fprintf(stderr, ended ? "[lwcli session ended]\n" : "[lwcli detached]\n");
+      return EXIT_SUCCESS;
+    }
+  } // anonymous
+
+  int session(const std::string& path, const char* const argv[])
+  {
+    try
+    {
+      if (!argv || !argv[0])
+        throw std::invalid_argument{"lwcli::attach::session given nullptr"};
+
+      int server = connect_unix(path);
+      if (server < 0)
+      {
+        start_session(path, argv);
+        server = connect_unix(path);
+        if (server < 0)
+          throw std::runtime_error{"unable to connect to " + path};
+      }
+      return relay(server);
+    }
+    catch (const std::exception& e)
+    {
+      std::fprintf(stderr, "Fatal Error: %s\n", e.what());
+    }
+    return EXIT_FAILURE;
+  }
+}} // lwcli // attach
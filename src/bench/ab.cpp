@@ -0,0 +1,324 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <lws_frontend.h>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "lwcli_config.h"
+#include "mock/wallet.h"
+#include "util.h"
+#include "wallet_config.h"
+#include "wallet_open.h"
+
+/* Runs one backend through the same wallet operations and prints one tab
+  separated line per operation. Each backend runs in its own process (see
+  ab.sh) so RSS numbers are not polluted by the other library. */
+
+namespace
+{
+  constexpr const char password[] = "lwcli-ab";
+
+  struct options
+  {
+    std::string backend = "lws";
+    std::string server;
+    std::string dest;
+    std::string amount = "0.001";
+    std::string directory = "/tmp";
+    std::uint64_t height = 0;
+    std::uint64_t ssl = 0;
+    bool header = false;
+  };
+
+  struct usage
+  {
+    std::chrono::steady_clock::time_point wall;
+    std::chrono::microseconds cpu;
+  };
+
+  std::chrono::microseconds cpu_time()
+  {
+    rusage self{};
+    if (getrusage(RUSAGE_SELF, std::addressof(self)) != 0)
+      throw std::runtime_error{"getrusage failed"};
+    const auto convert = [] (const timeval& value)
+    {
+      return std::chrono::seconds{value.tv_sec} + std::chrono::microseconds{value.tv_usec};
+    };
+    return convert(self.ru_utime) + convert(self.ru_stime);
+  }
+
+  //! \return Current resident set in KiB, from /proc/self/statm.
+  std::uint64_t rss_kib()
+  {
+    std::FILE* const file = std::fopen("/proc/self/statm", "r");
+    if (!file)
+      return 0;
+    unsigned long long pages = 0;
+    unsigned long long resident = 0;
+    const int read = std::fscanf(file, "%llu %llu", std::addressof(pages), std::addressof(resident));
+    std::fclose(file);
+    if (read != 2)
+      return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+  }
+
+  std::uint64_t peak_rss_kib()
+  {
+    rusage self{};
+    if (getrusage(RUSAGE_SELF, std::addressof(self)) != 0)
+      return 0;
+    return self.ru_maxrss;
+  }
+
+  usage start()
+  {
+    return {std::chrono::steady_clock::now(), cpu_time()};
+  }
+
+  void report(const options& opts, const char* op, const usage& begin, const bool success)
+  {
+    const auto wall = std::chrono::steady_clock::now() - begin.wall;
+    const auto cpu = cpu_time() - begin.cpu;
+    std::printf(
+      "%s\t%s\t%.3f\t%.3f\t%llu\t%llu\t%s\n",
+      opts.backend.c_str(), op,
+      std::chrono::duration<double, std::milli>{wall}.count(),
+      std::chrono::duration<double, std::milli>{cpu}.count(),
+      (unsigned long long)rss_kib(), (unsigned long long)peak_rss_kib(),
+      success ? "ok" : "fail"
+    );
+    std::fflush(stdout);
+  }
+
+  std::shared_ptr<Monero::WalletManager> get_wallet_manager(const options& opts)
+  {
+    std::shared_ptr<Monero::WalletManager> wm;
+    if (opts.backend == "lws")
+      wm.reset(lwsf::WalletManagerFactory::getWalletManager());
+#ifdef LWCLI_WALLET2_ENABLED
+    else if (opts.backend == "monerod")
+      wm.reset(Monero::WalletManagerFactory::getWalletManager());
+#endif
+    else if (opts.backend == "mock")
+      wm.reset(lwcli::mock::wallet_manager(lwcli::mock::config{}));
+    else
+      throw std::runtime_error{"--backend value is not valid"};
+    return wm;
+  }
+
+  //! Deletes the temporary wallet files after the wallet is closed
+  struct remove_wallet
+  {
+    const std::string path;
+
+    ~remove_wallet()
+    {
+      std::remove(path.c_str());
+      std::remove((path + ".keys").c_str());
+    }
+  };
+
+  bool check(Monero::Wallet& wal)
+  {
+    int status = 0;
+    std::string error;
+    wal.statusWithErrorString(status, error);
+    if (status != Monero::Wallet::Status_Ok)
+      std::fprintf(stderr, "%s\n", error.c_str());
+    return status == Monero::Wallet::Status_Ok;
+  }
+
+  int run(const options& opts, const std::string& seed)
+  {
+    const auto wm = get_wallet_manager(opts);
+    const remove_wallet cleanup{opts.directory + "/lwcli-ab-" + opts.backend + "-" + std::to_string(getpid())};
+    const std::string& path = cleanup.path;
+
+    // restored file is setup, not measured; both backends start from the same keys
+    {
+      Monero::Wallet* const wal = wm->recoveryWallet(path, password, seed, lwcli::config::network, opts.height);
+      if (!wal || !check(*wal))
+        throw std::runtime_error{"Unable to restore wallet from seed"};
+
+      lwcli::config::wallet_store settings;
+      settings.set<lwcli::config::keys::url>(opts.server);
+      settings.set<lwcli::config::keys::ssl>(bool(opts.ssl));
+      settings.store(*wal);
+      wm->closeWallet(wal, true /* store */);
+    }
+
+    if (opts.header)
+      std::printf("backend\top\twall_ms\tcpu_ms\trss_kib\tpeak_rss_kib\tstatus\n");
+
+    auto begin = start();
+    std::string error;
+    const std::shared_ptr<Monero::Wallet> wal =
+      lwcli::prep_wallet(wm, wm->openWallet(path, password, lwcli::config::network), std::addressof(error));
+    report(opts, "open", begin, bool(wal));
+    if (!wal)
+      throw std::runtime_error{error};
+
+    begin = start();
+    const bool initialized = lwcli::init_wallet(*wal, std::addressof(error));
+    report(opts, "init", begin, initialized);
+    if (!initialized)
+      throw std::runtime_error{error};
+
+    begin = start();
+    const bool refreshed = wal->refresh();
+    report(opts, "first_refresh", begin, refreshed && check(*wal));
+
+    begin = start();
+    Monero::TransactionHistory* const history = wal->history();
+    if (history)
+    {
+      history->refresh();
+      history->getAll();
+    }
+    report(opts, "history_load", begin, history != nullptr);
+
+    begin = start();
+    Monero::Subaddress* const subaddress = wal->subaddress();
+    if (subaddress)
+    {
+      subaddress->addRow(0, "lwcli-ab");
+      subaddress->refresh(0);
+    }
+    report(opts, "subaddress_create", begin, subaddress != nullptr && check(*wal));
+
+    if (!opts.dest.empty())
+    {
+      const std::optional<std::uint64_t> amount = lwsf::amountFromString(opts.amount);
+      if (!amount)
+        throw std::runtime_error{"--amount value is not valid"};
+
+      begin = start();
+      Monero::PendingTransaction* const tx =
+        wal->createTransaction(opts.dest, "", *amount, 0 /* mixin_count */, Monero::PendingTransaction::Priority_Default, 0);
+      const bool constructed = tx && tx->status() == Monero::PendingTransaction::Status_Ok;
+      report(opts, "tx_construct", begin, constructed);
+      if (tx && !constructed)
+        std::fprintf(stderr, "%s\n", tx->errorString().c_str());
+      if (tx)
+        wal->disposeTransaction(tx);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  bool parse(options& opts, const int argc, const char* argv[])
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string_view arg{argv[i]};
+      if (arg == "--header")
+      {
+        opts.header = true;
+        continue;
+      }
+      if (argc <= i + 1)
+        return false;
+
+      const char* const value = argv[++i];
+      if (arg == "--backend")
+        opts.backend = value;
+      else if (arg == "--server")
+        opts.server = value;
+      else if (arg == "--dest")
+        opts.dest = value;
+      else if (arg == "--amount")
+        opts.amount = value;
+      else if (arg == "--dir")
+        opts.directory = value;
+      else if (arg == "--height" || arg == "--ssl")
+      {
+        const auto number = lwcli::from_string(value);
+        if (!number)
+          return false;
+        (arg == "--height" ? opts.height : opts.ssl) = *number;
+      }
+      else if (arg == "--network")
+      {
+        if (std::strcmp("main", value) == 0)
+          lwcli::config::network = Monero::MAINNET;
+        else if (std::strcmp("stage", value) == 0)
+          lwcli::config::network = Monero::STAGENET;
+        else if (std::strcmp("test", value) == 0)
+          lwcli::config::network = Monero::TESTNET;
+        else
+          return false;
+      }
+      else
+        return false;
+    }
+    return !opts.server.empty() || opts.backend == "mock";
+  }
+}
+
+int main(int argc, const char* argv[])
+{
+  options opts{};
+  if (!parse(opts, argc, argv))
+  {
+    std::fprintf(
+      stderr,
+      "Usage: %s --backend lws|monerod|mock --server url [--ssl n] [--network main|stage|test]\n"
+      "\t[--height restore] [--dest address] [--amount xmr] [--dir path] [--header]\n"
+      "Mnemonic seed is read from stdin\n",
+      argc ? argv[0] : "lwcli-ab"
+    );
+    return EXIT_FAILURE;
+  }
+
+  try
+  {
+    std::string seed;
+    std::getline(std::cin, seed);
+    if (seed.empty() && opts.backend != "mock")
+      throw std::runtime_error{"No mnemonic seed on stdin"};
+    return run(opts, seed);
+  }
+  catch (const std::exception& e)
+  {
+    std::fprintf(stderr, "Fatal Error: %s\n", e.what());
+  }
+  return EXIT_FAILURE;
+}
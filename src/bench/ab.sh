@@ -0,0 +1,124 @@
+#!/bin/sh
+# Copyright (c) 2025, Cifro Codes LLC
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification, are
+# permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this list of
+#    conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this list
+#    of conditions and the following disclaimer in the documentation and/or other
+#    materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its contributors may be
+#    used to endorse or promote products derived from this software without specific
+#    prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+# THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+# THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs lwcli-ab against both backends and prints median wall/CPU/RSS per
+# operation side by side. Point the servers at local instances (lws and
+# monerod on a private testnet/regtest) so network jitter stays out of it.
+#
+#   ab.sh -s seed.txt -l http://127.0.0.1:8443 -m http://127.0.0.1:28081 \
+#     [-b ./src/bench/lwcli-ab] [-n runs] [-N test] [-H height] [-d address] [-a amount]
+
+set -eu
+
+bin=./src/bench/lwcli-ab
+runs=5
+network=test
+height=0
+dest=
+amount=0.001
+seed=
+lws=
+monerod=
+
+while getopts "a:b:d:H:l:m:n:N:s:" opt; do
+  case "$opt" in
+    a) amount=$OPTARG ;;
+    b) bin=$OPTARG ;;
+    d) dest=$OPTARG ;;
+    H) height=$OPTARG ;;
+    l) lws=$OPTARG ;;
+    m) monerod=$OPTARG ;;
+    n) runs=$OPTARG ;;
+    N) network=$OPTARG ;;
+    s) seed=$OPTARG ;;
+    *) exit 1 ;;
+  esac
+done
+
+if [ -z "$seed" ] || [ -z "$lws" ] || [ -z "$monerod" ]; then
+  echo "-s seed file, -l lws url and -m monerod url are required" >&2
+  exit 1
+fi
+
+results=$(mktemp)
+trap 'rm -f "$results"' EXIT
+
+run() {
+  backend=$1
+  server=$2
+  set -- --backend "$backend" --server "$server" --network "$network" --height "$height" --amount "$amount"
+  if [ -n "$dest" ]; then
+    set -- "$@" --dest "$dest"
+  fi
+  "$bin" "$@" < "$seed" >> "$results"
+}
+
+i=0
+while [ "$i" -lt "$runs" ]; do
+  # alternate order so cache warmth does not favor one backend
+  if [ $((i % 2)) -eq 0 ]; then
+    run lws "$lws"
+    run monerod "$monerod"
+  else
+    run monerod "$monerod"
+    run lws "$lws"
+  fi
+  i=$((i + 1))
+done
+
+# median of each column per (backend, op), failures excluded
+sort -t "$(printf '\t')" -k1,1 -k2,2 "$results" | awk -F '\t' '
+  function median(list, count,    values, n, i, j, tmp) {
+    n = split(list, values, " ")
+    for (i = 2; i <= n; ++i)
+      for (j = i; 1 < j && values[j - 1] + 0 > values[j] + 0; --j) {
+        tmp = values[j]; values[j] = values[j - 1]; values[j - 1] = tmp
+      }
+    return n % 2 ? values[(n + 1) / 2] : (values[n / 2] + values[n / 2 + 1]) / 2
+  }
+  $7 == "ok" {
+    key = $2
+    ops[key] = 1
+    wall[$1, key] = wall[$1, key] " " $3
+    cpu[$1, key] = cpu[$1, key] " " $4
+    rss[$1, key] = rss[$1, key] " " $6
+  }
+  END {
+    printf "%-18s %12s %12s %12s %12s %12s %12s\n", "op", "lws wall", "wallet2 wall", "lws cpu", "wallet2 cpu", "lws rss", "wallet2 rss"
+    split("open init first_refresh history_load subaddress_create tx_construct", order, " ")
+    for (i = 1; i <= 6; ++i) {
+      op = order[i]
+      if (!(op in ops))
+        continue
+      printf "%-18s %10.1fms %10.1fms %10.1fms %10.1fms %9dKiB %9dKiB\n", op,
+        median(wall["lws", op]), median(wall["monerod", op]),
+        median(cpu["lws", op]), median(cpu["monerod", op]),
+        median(rss["lws", op]), median(rss["monerod", op])
+    }
+  }'
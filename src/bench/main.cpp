@@ -0,0 +1,462 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <ftxui/screen/screen.hpp>
+#include <lws_frontend.h>
+#include <memory>
+#include <new>
+#include <sys/resource.h>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "components/frame.h"
+#include "components/table.h"
+#include "decorate/overlay.h"
+#include "decorate/qrcode.h"
+#include "events.h"
+#include "lwcli_config.h"
+#include "mock/wallet.h"
+#include "timer.h"
+#include "util.h"
+#include "views/accounts.h"
+#include "views/history.h"
+#include "views/send.h"
+#include "views/wallet.h"
+
+namespace
+{
+  std::atomic<std::size_t> allocations{0};
+}
+
+// counts every heap allocation made by the measured code
+void* operator new(const std::size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void* const out = std::malloc(size ? size : 1);
+  if (!out)
+    throw std::bad_alloc{};
+  return out;
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+  // address from views/send.h, valid for the testnet mock wallet
+  constexpr const char address[] =
+    "9sMNg6xAhC15Y2r51xthUaHCuKDiFaojSBaSPUrAeBosZBYahFEii7dDq6y3pgaNUzBhvKmxPpWdnPquzsVLkDWB9JM3tiS";
+
+  struct dimensions
+  {
+    int width;
+    int height;
+  };
+
+  constexpr const dimensions sizes[] = {{80, 24}, {120, 40}, {200, 60}};
+  constexpr const std::size_t row_counts[] = {100, 1000, 10000};
+
+  struct settings
+  {
+    std::string filter;
+    std::size_t iterations = 50;
+  };
+
+  std::size_t sink = 0; // keeps the optimizer from dropping frames
+
+  std::shared_ptr<Monero::Wallet> open_mock(const lwcli::mock::config& cfg)
+  {
+    const std::shared_ptr<Monero::WalletManager> wm{lwcli::mock::wallet_manager(cfg)};
+    return std::shared_ptr<Monero::Wallet>{
+      wm->openWallet("bench", "", Monero::TESTNET), [wm] (Monero::Wallet* ptr) { wm->closeWallet(ptr, false); }
+    };
+  }
+
+  //! Same work as one ScreenInteractive frame, minus the terminal write.
+  void draw(ftxui::Screen& screen, ftxui::Element element)
+  {
+    screen.Clear();
+    ftxui::Render(screen, element);
+    sink += screen.ToString().size();
+  }
+
+  void type(const ftxui::Component& component, const char* text)
+  {
+    for (; *text; ++text)
+      component->OnEvent(ftxui::Event::Character(*text));
+  }
+
+  template<typename F>
+  void measure(const settings& opts, const char* name, const dimensions size, const std::size_t rows, F&& frame)
+  {
+    if (!opts.filter.empty() && std::strstr(name, opts.filter.c_str()) == nullptr)
+      return;
+
+    for (unsigned i = 0; i < 3; ++i)
+      frame(); // warm caches and lazy state
+
+    std::vector<std::uint64_t> samples;
+    samples.reserve(opts.iterations);
+
+    std::size_t allocated = 0;
+    for (std::size_t i = 0; i < opts.iterations; ++i)
+    {
+      const std::size_t before = allocations.load(std::memory_order_relaxed);
+      const auto start = std::chrono::steady_clock::now();
+      frame();
+      const auto end = std::chrono::steady_clock::now();
+      allocated += allocations.load(std::memory_order_relaxed) - before;
+      samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    std::uint64_t total = 0;
+    for (const std::uint64_t sample : samples)
+      total += sample;
+    std::sort(samples.begin(), samples.end());
+
+    const std::size_t count = samples.size();
+    std::printf(
+      "%-16s %4dx%-3d %6zu %14.0f %14llu %14llu %12.1f\n",
+      name, size.width, size.height, rows,
+      double(total) / count,
+      (unsigned long long)samples[count / 2],
+      (unsigned long long)samples[std::min(count - 1, (count * 99) / 100)],
+      double(allocated) / count
+    );
+    std::fflush(stdout);
+  }
+
+  std::vector<std::vector<std::string>> make_rows(const std::size_t count)
+  {
+    std::vector<std::vector<std::string>> rows;
+    rows.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      rows.push_back({
+        "2024/01/01 ", "1.000000000000", "", "label " + std::to_string(i), "",
+        std::to_string(2000000 + i), "0.000030000000", "0123456789abcdef..."
+      });
+    }
+    return rows;
+  }
+
+  void run_table(const settings& opts, const dimensions size, const std::size_t count)
+  {
+    const auto rows = make_rows(count);
+    const auto table = lwcli::component::table(
+      {"Date", "Amount", "Payment ID", "Label", "Desription", "Block", "Fee", "Hash"},
+      [&rows] () { return rows; },
+      [] (ftxui::Event, std::size_t) { return false; }
+    );
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "table", size, count, [&] () {
+      draw(screen, table->Render() | ftxui::vscroll_indicator | ftxui::yframe);
+    });
+
+    // pointer sliding along one row, which reuses the previous frame
+    const auto cached = lwcli::component::frame_cache(table);
+    draw(screen, cached->Render());
+    ftxui::Mouse mouse{};
+    mouse.button = ftxui::Mouse::None;
+    mouse.motion = ftxui::Mouse::Released;
+    mouse.y = 3;
+    measure(opts, "table.hover", size, count, [&] () {
+      mouse.x = (mouse.x + 1) % size.width;
+      cached->OnEvent(ftxui::Event::Mouse("", mouse));
+      draw(screen, cached->Render());
+    });
+  }
+
+  void run_history(const settings& opts, const dimensions size, const std::size_t count)
+  {
+    lwcli::mock::config cfg{};
+    cfg.txs = count;
+    cfg.accounts = 1;
+    const auto wal = open_mock(cfg);
+    const auto history = lwcli::view::history(wal, 0);
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "history", size, count, [&] () { draw(screen, history->Render()); });
+    measure(opts, "history.load", size, count, [&] () { history->OnEvent(lwcli::event::refresh_wallet); });
+
+    // an ignored key press, which reuses the previous frame
+    const auto cached = lwcli::component::frame_cache(history);
+    measure(opts, "history.reuse", size, count, [&] () {
+      cached->OnEvent(ftxui::Event::Character('z'));
+      draw(screen, cached->Render());
+    });
+  }
+
+  void run_accounts(const settings& opts, const dimensions size, const std::size_t count)
+  {
+    lwcli::mock::config cfg{};
+    cfg.txs = 100;
+    cfg.accounts = count;
+    cfg.subaddresses = 1;
+    const auto wal = open_mock(cfg);
+
+    std::uint32_t account = 0;
+    const auto accounts = lwcli::view::accounts(wal, &account);
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "accounts", size, count, [&] () { draw(screen, accounts->Render()); });
+  }
+
+  void run_overlay(const settings& opts, const dimensions size, const std::size_t count)
+  {
+    ftxui::Elements lines;
+    lines.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+      lines.push_back(ftxui::text("background row " + std::to_string(i)));
+    const ftxui::Element base = ftxui::vbox(std::move(lines));
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "overlay", size, count, [&] () {
+      auto details = ftxui::window(ftxui::text("Tx"), ftxui::vbox({
+        ftxui::text("Description: "), ftxui::separator(), ftxui::text("Amount: 1.000000000000")
+      }));
+      draw(screen, ftxui::dbox(base, lwcli::decorate::overlay(std::move(details))));
+    });
+  }
+
+  void run_qr_code(const settings& opts, const dimensions size)
+  {
+    const auto wal = open_mock(lwcli::mock::config{});
+    const auto raw = lwsf::qrcode(wal.get(), 0, 0);
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "qr_code", size, raw.size(), [&] () {
+      auto canvas = lwcli::decorate::make_qr_code(raw);
+      draw(screen, ftxui::canvas(std::move(canvas)));
+    });
+  }
+
+  //! Fills one destination and presses "Construct Tx" in a `view::send`.
+  void construct_tx(ftxui::Screen& screen, const ftxui::Component& send)
+  {
+    // buttons -> priority -> first destination row
+    send->OnEvent(ftxui::Event::ArrowDown);
+    send->OnEvent(ftxui::Event::ArrowDown);
+    type(send, "0.5");
+    send->OnEvent(ftxui::Event::ArrowRight);
+    type(send, address);
+    draw(screen, send->Render());
+
+    // back to "Construct Tx"
+    send->OnEvent(ftxui::Event::ArrowUp);
+    send->OnEvent(ftxui::Event::ArrowUp);
+    send->OnEvent(ftxui::Event::ArrowRight);
+    send->OnEvent(ftxui::Event::ArrowRight);
+    send->OnEvent(ftxui::Event::Return);
+  }
+
+  void run_send(const settings& opts, const dimensions size)
+  {
+    lwcli::mock::config cfg{};
+    cfg.txs = 100;
+    const std::shared_ptr<Monero::WalletManager> wm{lwcli::mock::wallet_manager(cfg)};
+    const std::shared_ptr<Monero::Wallet> wal{
+      wm->openWallet("bench", "", Monero::TESTNET), [wm] (Monero::Wallet* ptr) { wm->closeWallet(ptr, false); }
+    };
+
+    ftxui::Screen screen{size.width, size.height};
+    measure(opts, "send", size, 1, [&] () {
+      const auto send = lwcli::view::send(wm, wal, 0);
+      construct_tx(screen, send);
+
+      // spin until the confirm dialog replaces the progress banner
+      for (unsigned i = 0; i < 10000; ++i)
+      {
+        draw(screen, send->Render());
+        if (screen.ToString().find("Constructing Transaction") == std::string::npos)
+          break;
+      }
+    });
+  }
+
+  //! \return Context switches of every thread but the caller, which polls.
+  std::uint64_t context_switches()
+  {
+    struct rusage all{};
+    struct rusage self{};
+    if (getrusage(RUSAGE_SELF, std::addressof(all)) != 0 || getrusage(RUSAGE_THREAD, std::addressof(self)) != 0)
+      return 0;
+    return std::uint64_t(all.ru_nvcsw + all.ru_nivcsw) - std::uint64_t(self.ru_nvcsw + self.ru_nivcsw);
+  }
+
+  /*! Stands in for `ScreenInteractive::Loop` over `window`: `event::redraw`
+    and a frame for each `timer::redraw`. Counts over wall-clock time, so
+    only run when named exactly. */
+  void idle_case(const char* name, const std::chrono::seconds window, const ftxui::Component& root)
+  {
+    ftxui::Screen screen{120, 40};
+    draw(screen, root->Render());
+
+    const std::uint64_t wakeups = lwcli::timer::wakeups();
+    const std::uint64_t switches = context_switches();
+    std::uint64_t posted = lwcli::timer::redraws();
+    std::uint64_t frames = 0;
+
+    const auto end = std::chrono::steady_clock::now() + window;
+    while (std::chrono::steady_clock::now() < end)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+      const std::uint64_t latest = lwcli::timer::redraws();
+      if (latest == posted)
+        continue;
+
+      posted = latest; // posts between polls share one frame, as in FTXUI
+      root->OnEvent(lwcli::event::redraw);
+      draw(screen, root->Render());
+      ++frames;
+    }
+
+    const double minutes = std::chrono::duration<double, std::ratio<60>>{window}.count();
+    std::printf(
+      "%-16s %14.1f %14.1f %18.1f\n", name,
+      double(frames) / minutes,
+      double(lwcli::timer::wakeups() - wakeups) / minutes,
+      double(context_switches() - switches) / minutes
+    );
+    std::fflush(stdout);
+  }
+
+  void run_idle(const std::chrono::seconds window)
+  {
+    std::printf("%-16s %14s %14s %18s\n", "case", "frames/min", "wakeups/min", "ctx switches/min");
+
+    // an idle lwcli: only the inactivity lock is pending
+    const lwcli::timer::id lock = lwcli::timer::schedule(
+      lwcli::timer::clock::now() + lwcli::config::wallet_timeout, [] () { return lwcli::timer::done; }
+    );
+
+    lwcli::mock::config cfg{};
+    cfg.txs = 100;
+    {
+      const std::shared_ptr<Monero::WalletManager> wm{lwcli::mock::wallet_manager(cfg)};
+      const std::shared_ptr<Monero::Wallet> wal{
+        wm->openWallet("bench", "", Monero::TESTNET), [wm] (Monero::Wallet* ptr) { wm->closeWallet(ptr, false); }
+      };
+      idle_case("wallet", window, lwcli::view::wallet(wm, wal));
+    }
+
+    // connect and refresh in the background, then idle
+    {
+      const std::shared_ptr<Monero::WalletManager> wm{lwcli::mock::wallet_manager(cfg)};
+      const std::shared_ptr<Monero::Wallet> wal{
+        wm->openWallet("bench", "", Monero::TESTNET), [wm] (Monero::Wallet* ptr) { wm->closeWallet(ptr, false); }
+      };
+      idle_case("wallet.connect", window, lwcli::view::wallet(wm, wal, true));
+    }
+
+    // a slow transaction keeps the send spinner up for the whole window
+    cfg.latency = window;
+    const std::shared_ptr<Monero::WalletManager> wm{lwcli::mock::wallet_manager(cfg)};
+    const std::shared_ptr<Monero::Wallet> wal{
+      wm->openWallet("bench", "", Monero::TESTNET), [wm] (Monero::Wallet* ptr) { wm->closeWallet(ptr, false); }
+    };
+    {
+      ftxui::Screen screen{120, 40};
+      const auto send = lwcli::view::send(wm, wal, 0);
+      construct_tx(screen, send);
+      idle_case("send.spinner", window, send);
+    }
+
+    // the same spinner covered after one frame, so never re-armed
+    {
+      ftxui::Screen screen{120, 40};
+      const auto send = lwcli::view::send(wm, wal, 0);
+      construct_tx(screen, send);
+      draw(screen, send->Render());
+      idle_case("send.hidden", window, ftxui::Renderer([] () { return ftxui::text("covered"); }));
+    }
+
+    lwcli::timer::cancel(lock);
+  }
+}
+
+int main(int argc, const char* argv[])
+{
+  settings opts{};
+  if (1 < argc)
+    opts.filter = argv[1];
+  if (2 < argc)
+  {
+    const auto iterations = lwcli::from_string(argv[2]);
+    if (!iterations || !*iterations)
+    {
+      std::fprintf(stderr, "Usage: %s [case filter | idle] [iterations]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+    opts.iterations = *iterations;
+  }
+
+  try
+  {
+    if (opts.filter == "idle")
+    {
+      run_idle(std::chrono::seconds{10});
+      return EXIT_SUCCESS;
+    }
+
+    std::printf(
+      "%-16s %8s %6s %14s %14s %14s %12s\n",
+      "case", "size", "rows", "ns/frame", "p50 ns", "p99 ns", "allocs/frame"
+    );
+    for (const dimensions size : sizes)
+    {
+      for (const std::size_t rows : row_counts)
+      {
+        run_table(opts, size, rows);
+        run_history(opts, size, rows);
+        run_accounts(opts, size, rows);
+        run_overlay(opts, size, rows);
+      }
+      run_qr_code(opts, size);
+      run_send(opts, size);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::fprintf(stderr, "Fatal Error: %s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return sink ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "history.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lwcli { namespace cache
+{
+  namespace
+  {
+    constexpr const std::string_view suffix{".lwcli-history"};
+    constexpr const std::string_view magic{"lwcli-h2"}; //!< Authenticated with the salt, not encrypted
+    constexpr const std::size_t salt_size = 16;
+    constexpr const std::size_t nonce_size = 12;
+    constexpr const std::size_t tag_size = 16;
+    constexpr const std::size_t header_size = magic.size() + salt_size + nonce_size + tag_size;
+
+    //! PBKDF2-HMAC-SHA256 rounds; paid once per wallet open
+    constexpr const int kdf_rounds = 100000;
+
+    //! Bounds on decoded sizes, so a damaged file cannot ask for huge allocations
+    constexpr const std::uint32_t max_columns = 64;
+
+    struct free_cipher
+    {
+      void operator()(EVP_CIPHER_CTX* ptr) const noexcept { ::EVP_CIPHER_CTX_free(ptr); }
+    };
+    using cipher_context = std::unique_ptr<EVP_CIPHER_CTX, free_cipher>;
+
+    class descriptor
+    {
+      int fd_;
+
+    public:
+      explicit descriptor(const int fd) noexcept
+        : fd_(fd)
+      {}
+
+      ~descriptor() noexcept
+      {
+        if (0 <= fd_)
+          ::close(fd_);
+      }
+
+      descriptor(const descriptor&) = delete;
+      descriptor& operator=(const descriptor&) = delete;
+
+      int get() const noexcept { return fd_; }
+
+      //! \return `fd` so the caller can check the `close` result.
+      int release() noexcept
+      {
+        const int fd = fd_;
+        fd_ = -1;
+        return fd;
+      }
+    };
+
+    class mapping
+    {
+      void* data_;
+      std::size_t size_;
+
+    public:
+      mapping(const int fd, const std::size_t size) noexcept
+        : data_(::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)), size_(size)
+      {}
+
+      ~mapping() noexcept
+      {
+        if (data_ != MAP_FAILED)
+          ::munmap(data_, size_);
+      }
+
+      mapping(const mapping&) = delete;
+      mapping& operator=(const mapping&) = delete;
+
+      explicit operator bool() const noexcept { return data_ != MAP_FAILED; }
+      std::string_view view() const noexcept { return {static_cast<const char*>(data_), size_}; }
+    };
+
+    void put32(std::string& out, const std::uint32_t value)
+    {
+      for (unsigned i = 0; i < 4; ++i)
+        out.push_back(char((value >> (i * 8)) & 0xff));
+    }
+
+    void put_string(std::string& out, const std::string& value)
+    {
+      put32(out, std::uint32_t(value.size()));
+      out.append(value);
+    }
+
+    //! Reads the format written by `serialize`; any overrun sets `failed`.
+    struct reader
+    {
+      std::string_view bytes;
+      bool failed = false;
+
+      std::uint32_t get32()
+      {
+        if (bytes.size() < 4)
+        {
+          failed = true;
+          return 0;
+        }
+        std::uint32_t value = 0;
+        for (unsigned i = 0; i < 4; ++i)
+          value |= std::uint32_t(static_cast<unsigned char>(bytes[i])) << (i * 8);
+        bytes.remove_prefix(4);
+        return value;
+      }
+
+      std::string get_string()
+      {
+        const std::uint32_t size = get32();
+        if (failed || bytes.size() < size)
+        {
+          failed = true;
+          return {};
+        }
+        std::string value{bytes.substr(0, size)};
+        bytes.remove_prefix(size);
+        return value;
+      }
+    };
+
+    std::string serialize(const std::map<std::uint32_t, account_rows>& accounts)
+    {
+      std::string out;
+      put32(out, std::uint32_t(accounts.size()));
+      for (const auto& account : accounts)
+      {
+        const std::size_t columns = account.second.rows.empty() ? 0 : account.second.rows.front().size();
+        put32(out, account.first);
+        put_string(out, account.second.balance);
+        put32(out, std::uint32_t(account.second.rows.size()));
+        put32(out, std::uint32_t(columns));
+        for (const auto& row : account.second.rows)
+        {
+          for (std::size_t i = 0; i < columns; ++i)
+            put_string(out, i < row.size() ? row[i] : std::string{});
+        }
+      }
+      return out;
+    }
+
+    bool deserialize(const std::string_view bytes, std::map<std::uint32_t, account_rows>& out)
+    {
+      reader in{bytes};
+      const std::uint32_t count = in.get32();
+      for (std::uint32_t i = 0; i < count && !in.failed; ++i)
+      {
+        const std::uint32_t index = in.get32();
+        account_rows account{in.get_string(), {}};
+        const std::uint32_t rows = in.get32();
+        const std::uint32_t columns = in.get32();
+
+        // every cell takes at least 4 bytes
+        if (in.failed || max_columns < columns || (columns && in.bytes.size() / (4 * columns) < rows))
+          return false;
+
+        account.rows.resize(rows);
+        for (auto& row : account.rows)
+        {
+          row.reserve(columns);
+          for (std::uint32_t column = 0; column < columns; ++column)
+            row.push_back(in.get_string());
+        }
+        out[index] = std::move(account);
+      }
+      return !in.failed && in.bytes.empty();
+    }
+
+    /*! `encrypt` selects direction. GCM output is the same size as input.
+      `tag` is written when encrypting and checked when decrypting. `magic`
+      and `salt` are authenticated. */
+    bool crypt(const bool encrypt, const std::array<unsigned char, 32>& key, const std::array<unsigned char, salt_size>& salt, const unsigned char* nonce, unsigned char* tag, const std::string_view in, std::string& out)
+    {
+      cipher_context ctx{::EVP_CIPHER_CTX_new()};
+      if (!ctx)
+        return false;
+
+      const auto init = encrypt ? ::EVP_EncryptInit_ex : ::EVP_DecryptInit_ex;
+      const auto update = encrypt ? ::EVP_EncryptUpdate : ::EVP_DecryptUpdate;
+      if (init(ctx.get(), ::EVP_aes_256_gcm(), nullptr, nullptr, nullptr) != 1)
+        return false;
+      if (::EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, nonce_size, nullptr) != 1)
+        return false;
+      if (init(ctx.get(), nullptr, nullptr, key.data(), nonce) != 1)
+        return false;
+
+      int length = 0;
+      const auto* aad = reinterpret_cast<const unsigned char*>(magic.data());
+      if (update(ctx.get(), nullptr, &length, aad, int(magic.size())) != 1)
+        return false;
+      if (update(ctx.get(), nullptr, &length, salt.data(), int(salt.size())) != 1)
+        return false;
+
+      out.resize(in.size());
+      auto* dest = reinterpret_cast<unsigned char*>(out.data());
+      if (update(ctx.get(), dest, &length, reinterpret_cast<const unsigned char*>(in.data()), int(in.size())) != 1)
+        return false;
+
+      if (encrypt)
+      {
+        return ::EVP_EncryptFinal_ex(ctx.get(), dest + length, &length) == 1 &&
+          ::EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, tag_size, tag) == 1;
+      }
+      return ::EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, tag_size, tag) == 1 &&
+        ::EVP_DecryptFinal_ex(ctx.get(), dest + length, &length) == 1;
+    }
+  } // anonymous
+
+  history::history(std::string wallet_path, const std::string& password)
+    : path_(std::move(wallet_path)), salt_{}, key_{}, accounts_(), enabled_(false), changed_(false)
+  {
+    {
+      // mock and in-memory wallets have a path but no file
+      struct stat wallet_file{};
+      if (path_.empty() || ::stat(path_.c_str(), &wallet_file) != 0)
+        return;
+    }
+    path_.append(suffix);
+
+    // an existing file keeps its salt, so its contents can be read
+    std::string_view bytes;
+    const descriptor file{::open(path_.c_str(), O_RDONLY | O_CLOEXEC)};
+    struct stat info{};
+    std::unique_ptr<mapping> mapped;
+    if (0 <= file.get() && ::fstat(file.get(), &info) == 0 && header_size < std::size_t(info.st_size))
+    {
+      mapped = std::make_unique<mapping>(file.get(), std::size_t(info.st_size));
+      if (*mapped)
+        bytes = mapped->view();
+    }
+
+    if (bytes.substr(0, magic.size()) == magic)
+    {
+      bytes.remove_prefix(magic.size());
+      std::memcpy(salt_.data(), bytes.data(), salt_.size());
+      bytes.remove_prefix(salt_.size());
+    }
+    else
+    {
+      bytes = {};
+      if (::RAND_bytes(salt_.data(), int(salt_.size())) != 1)
+        return;
+    }
+
+    enabled_ = ::PKCS5_PBKDF2_HMAC(
+      password.data(), int(password.size()), salt_.data(), int(salt_.size()),
+      kdf_rounds, ::EVP_sha256(), int(key_.size()), key_.data()
+    ) == 1;
+    if (!enabled_ || bytes.empty())
+      return;
+
+    std::array<unsigned char, nonce_size + tag_size> header{};
+    std::memcpy(header.data(), bytes.data(), header.size());
+    bytes.remove_prefix(header.size());
+
+    std::string plain;
+    if (!crypt(false, key_, salt_, header.data(), header.data() + nonce_size, bytes, plain))
+      return;
+
+    std::map<std::uint32_t, account_rows> accounts;
+    if (deserialize(plain, accounts))
+      accounts_ = std::move(accounts);
+    ::OPENSSL_cleanse(plain.data(), plain.size());
+  }
+
+  history::~history() noexcept
+  {
+    try
+    {
+      store();
+    }
+    catch (...)
+    {}
+    ::OPENSSL_cleanse(key_.data(), key_.size());
+  }
+
+  const account_rows* history::find(const std::uint32_t account) const
+  {
+    const auto match = accounts_.find(account);
+    if (match == accounts_.end())
+      return nullptr;
+    return std::addressof(match->second);
+  }
+
+  void history::update(const std::uint32_t account, account_rows rows)
+  {
+    if (!enabled_)
+      return;
+
+    const auto match = accounts_.find(account);
+    if (match != accounts_.end() && match->second.balance == rows.balance && match->second.rows == rows.rows)
+      return;
+    accounts_[account] = std::move(rows);
+    changed_ = true;
+  }
+
+  bool history::store()
+  {
+    if (!enabled_ || !changed_)
+      return true;
+
+    std::array<unsigned char, nonce_size + tag_size> header{};
+    if (::RAND_bytes(header.data(), nonce_size) != 1)
+      return false;
+
+    std::string plain = serialize(accounts_);
+    std::string encrypted;
+    const bool sealed = crypt(true, key_, salt_, header.data(), header.data() + nonce_size, plain, encrypted);
+    ::OPENSSL_cleanse(plain.data(), plain.size());
+    if (!sealed)
+      return false;
+
+    std::string contents{magic};
+    contents.append(reinterpret_cast<const char*>(salt_.data()), salt_.size());
+    contents.append(reinterpret_cast<const char*>(header.data()), header.size());
+    contents.append(encrypted);
+
+    // replace atomically so a crash never leaves a partial file
+    const std::string temp = path_ + ".tmp";
+    descriptor file{::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR)};
+    if (file.get() < 0)
+      return false;
+
+    std::string_view remaining{contents};
+    while (!remaining.empty())
+    {
+      const ssize_t written = ::write(file.get(), remaining.data(), remaining.size());
+      if (written <= 0)
+      {
+        ::unlink(temp.c_str());
+        return false;
+      }
+      remaining.remove_prefix(written);
+    }
+
+    if (::close(file.release()) != 0 || ::rename(temp.c_str(), path_.c_str()) != 0)
+    {
+      ::unlink(temp.c_str());
+      return false;
+    }
+    changed_ = false;
+    return true;
+  }
+}} // lwcli // cache
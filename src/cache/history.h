@@ -0,0 +1,84 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lwcli { namespace cache
+{
+  //! Last rendered state of one account, already sorted and formatted.
+  struct account_rows
+  {
+    std::string balance;
+    std::vector<std::vector<std::string>> rows;
+  };
+
+  /*! Sidecar file next to the wallet (`<wallet>.lwcli-history`) holding
+    history rows so the history view can draw before the backend has
+    refreshed. The file is AES-256-GCM encrypted with a PBKDF2 key from the
+    wallet password and a per-file salt. The view key is not used, because
+    light-wallet servers and view-only wallets have it. The file is mapped
+    and decrypted once on open, and written once on destruction if changed.
+    A missing, corrupt or foreign file, or one sealed with an old password,
+    reads as empty. */
+  class history
+  {
+    std::string path_;
+    std::array<unsigned char, 16> salt_;
+    std::array<unsigned char, 32> key_;
+    std::map<std::uint32_t, account_rows> accounts_;
+    bool enabled_;
+    bool changed_;
+
+  public:
+    /*! Derives the key and decrypts, which is slow by design; construct off
+      the UI thread. Disabled (never reads or writes) if `wallet_path` is
+      not a file. */
+    history(std::string wallet_path, const std::string& password);
+
+    //! Calls `store()`.
+    ~history() noexcept;
+
+    history(const history&) = delete;
+    history& operator=(const history&) = delete;
+
+    //! \return Cached rows of `account`, or `nullptr`.
+    const account_rows* find(std::uint32_t account) const;
+
+    //! Replaces the rows of `account` in memory. Cheap if unchanged.
+    void update(std::uint32_t account, account_rows rows);
+
+    //! Rewrites the file if `update` changed anything. \return False on write failure.
+    bool store();
+  };
+}} // lwcli // cache
@@ -0,0 +1,195 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "frame.h"
+
+#include <cstdint>
+#include <ftxui/component/event.hpp>
+#include <ftxui/component/mouse.hpp>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "events.h"
+#include "timer.h"
+#include "trace.h"
+
+namespace lwcli { namespace component
+{
+  namespace
+  {
+    //! Set by `mark_unchanged`, only touched on the UI thread
+    bool unchanged = false;
+
+    class frame_cache_ final : public ftxui::ComponentBase
+    {
+      const ftxui::Component child_;
+      ftxui::Element last_;
+      std::uint64_t version_;
+      std::uint64_t rendered_;
+
+      bool Focusable() const override final { return child_->Focusable(); }
+      ftxui::Component ActiveChild() override final { return child_; }
+
+      //! \return True for keyboard input; false for mouse, resize and named special events
+      static bool is_key(const ftxui::Event& event)
+      {
+        if (event.is_character())
+          return true;
+        if (event.is_mouse() || event.input().empty())
+          return false;
+        const unsigned char first = event.input().front();
+        return (0 < first && first < 0x20) || first == 0x7f; // escape sequences and control keys
+      }
+
+    public:
+      explicit frame_cache_(ftxui::Component&& child)
+        : ftxui::ComponentBase(),
+          child_(std::move(child)),
+          last_(nullptr),
+          version_(1),
+          rendered_(0)
+      {
+        Add(child_);
+      }
+
+      bool OnEvent(ftxui::Event event) override final
+      {
+        const bool key = is_key(event);
+        unchanged = false;
+        const bool handled = child_->OnEvent(std::move(event));
+        if (handled || (!key && !std::exchange(unchanged, false)))
+          ++version_;
+        return handled;
+      }
+
+      ftxui::Element OnRender() override final
+      {
+        if (last_ && rendered_ == version_)
+        {
+          LWCLI_TRACE("frame_cache_::reuse");
+          return last_;
+        }
+
+        last_ = child_->Render();
+        rendered_ = version_;
+        return last_;
+      }
+    };
+
+    class throttle_hover_ final : public ftxui::ComponentBase
+    {
+      const ftxui::Component child_;
+      const std::chrono::milliseconds interval_;
+      timer::clock::time_point last_;
+      std::optional<ftxui::Event> pending_;
+      bool armed_;
+
+      bool Focusable() const override final { return child_->Focusable(); }
+      ftxui::Component ActiveChild() override final { return child_; }
+
+    public:
+      explicit throttle_hover_(ftxui::Component&& child, const std::chrono::milliseconds interval)
+        : ftxui::ComponentBase(),
+          child_(std::move(child)),
+          interval_(interval),
+          last_(),
+          pending_(),
+          armed_(false)
+      {
+        Add(child_);
+      }
+
+      bool OnEvent(ftxui::Event event) override final
+      {
+        const auto now = timer::clock::now();
+        if (is_hover(event))
+        {
+          if (now - last_ < interval_)
+          {
+            pending_ = std::move(event);
+            if (!armed_)
+            {
+              armed_ = true;
+              timer::schedule(last_ + interval_, [] () { timer::redraw(); return timer::done; });
+            }
+            return true;
+          }
+
+          pending_.reset();
+          last_ = now;
+          return child_->OnEvent(std::move(event));
+        }
+
+        if (event == event::redraw)
+        {
+          armed_ = false;
+          if (pending_)
+          {
+            last_ = now;
+            child_->OnEvent(*std::exchange(pending_, std::nullopt));
+          }
+        }
+        else if (event.is_mouse())
+          pending_.reset(); // clicks and wheel carry their own position
+
+        return child_->OnEvent(std::move(event));
+      }
+
+      ftxui::Element OnRender() override final
+      {
+        return child_->Render();
+      }
+    };
+  } // anonymous
+
+  void mark_unchanged() noexcept
+  {
+    unchanged = true;
+  }
+
+  bool is_hover(const ftxui::Event& event)
+  {
+    // SGR mouse mode reports the released button, so `None` is only motion
+    return event.is_mouse() && event.mouse().button == ftxui::Mouse::None;
+  }
+
+  ftxui::Component throttle_hover(ftxui::Component child, const std::chrono::milliseconds interval)
+  {
+    if (!child)
+      throw std::invalid_argument{"lwcli::component::throttle_hover was given nullptr"};
+    return std::make_shared<throttle_hover_>(std::move(child), interval);
+  }
+
+  ftxui::Component frame_cache(ftxui::Component child)
+  {
+    if (!child)
+      throw std::invalid_argument{"lwcli::component::frame_cache was given nullptr"};
+    return std::make_shared<frame_cache_>(std::move(child));
+  }
+}} // lwcli // component
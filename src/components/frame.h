@@ -0,0 +1,54 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <ftxui/component/component_base.hpp>
+#include <ftxui/component/event.hpp>
+
+namespace lwcli { namespace component
+{
+  /*! Reuses the last Element from `child` until an event changes something.
+    An event is a change when `child` handles it, or when it is not a key
+    press: FTXUI widgets track mouse hover without reporting it as handled,
+    and lwcli's own events carry wallet or timer updates. */
+  ftxui::Component frame_cache(ftxui::Component child);
+
+  /*! Called from `OnEvent` by a component that consumed a mouse event
+    without changing anything, so `frame_cache` can reuse the frame. */
+  void mark_unchanged() noexcept;
+
+  /*! Delivers mouse hover (motion with no button) at most once per
+    `interval`. Hovers in between are dropped except for the newest, which
+    is delivered when the interval ends. Place outside `frame_cache`. */
+  ftxui::Component throttle_hover(ftxui::Component child, std::chrono::milliseconds interval);
+
+  //! \return True if `event` is pointer motion with no button held.
+  bool is_hover(const ftxui::Event& event);
+}} // lwscli // component
@@ -33,7 +33,9 @@
 #include <ftxui/dom/table.hpp>
 
 #include "decorate/overlay.h"
+#include "frame.h"
 #include "table.h"
+#include "trace.h"
 
 namespace lwcli { namespace component
 {
@@ -95,10 +97,49 @@ namespace lwcli { namespace component
       bool can_decrement() const noexcept
       { return min_row() <= selected_; }
 
+      //! \return True if `x`/`y` is inside the boxes of `row`.
+      bool hit_row(const std::ptrdiff_t row, const int x, const int y) const
+      {
+        if (row < 0 || boxes_.size() <= std::size_t(row))
+          return false;
+        const auto& boxes = boxes_[row];
+        return ftxui::Box::Union(std::get<0>(boxes), std::get<1>(boxes)).Contain(x, y);
+      }
+
+      //! Pointer motion only, redraws when the highlighted row changes
+      bool on_hover(const int x, const int y)
+      {
+        std::ptrdiff_t highlighted = -1;
+        if (hit_row(highlighted_, x, y))
+          highlighted = highlighted_; // still inside, skip the search
+        else if (box_.Contain(x, y))
+        {
+          const auto match = std::lower_bound(boxes_.begin(), boxes_.end(), y, [] (const auto& lhs, const auto rhs) {
+            return std::get<0>(lhs).y_min < rhs;
+          });
+          if (hit_row(match - boxes_.begin(), x, y))
+            highlighted = match - boxes_.begin();
+        }
+
+        if (highlighted == highlighted_)
+        {
+          if (box_.Contain(x, y))
+            mark_unchanged();
+          return false;
+        }
+
+        // leaving is not handled, so widgets outside the table still see the hover
+        highlighted_ = highlighted;
+        return box_.Contain(x, y);
+      }
+
       bool OnEvent(ftxui::Event event) override final
       {
+        LWCLI_TRACE("table_::OnEvent");
         const auto original = selected_;
-        if (event.is_mouse() && box_.Contain(event.mouse().x, event.mouse().y))
+        if (is_hover(event))
+          return on_hover(event.mouse().x, event.mouse().y);
+        else if (event.is_mouse() && box_.Contain(event.mouse().x, event.mouse().y))
         {
           if (event.mouse().button == ftxui::Mouse::WheelDown && can_increment())
           {
@@ -153,6 +194,7 @@ namespace lwcli { namespace component
 
       ftxui::Element OnRender() override final
       {
+        LWCLI_TRACE("table_::OnRender");
         auto rows = generator_();
         set_size(rows.size());
 
@@ -164,7 +206,7 @@ namespace lwcli { namespace component
         {
           auto title = table.SelectRow(0);
           title.Decorate(ftxui::bold);
-          title.SeparatorVertical(ftxui::LIGHT);
+          title.SeparatorVertical(decorate::border_style());
         }
 
         if (columns_)
@@ -29,12 +29,15 @@
 
 #include "overlay.h"
 
+#include "lwcli_config.h"
+
 namespace lwcli { namespace decorate
 {
   ftxui::Element banner(ftxui::Element inner)
   {
     return ftxui::hbox({ftxui::filler(), ftxui::hcenter(inner), ftxui::filler()});
   }
+
   ftxui::Element overlay(ftxui::Element base)
   {
     base->ComputeRequirement();
@@ -43,4 +46,29 @@ namespace lwcli { namespace decorate
     const auto bindy = ftxui::size(ftxui::HEIGHT, ftxui::EQUAL, required.min_y);
     return ftxui::center(bindx(bindy(ftxui::clear_under(base))));
   }
+
+  ftxui::Element window(ftxui::Element title, ftxui::Element content)
+  {
+    if (!config::low_bandwidth)
+      return ftxui::window(std::move(title), std::move(content));
+
+    // box-drawing characters are 3 bytes each in UTF-8
+    return ftxui::vbox({
+      ftxui::hbox({ftxui::text("+-"), std::move(title), ftxui::separatorCharacter("-") | ftxui::flex, ftxui::text("+")}),
+      ftxui::hbox({ftxui::separatorCharacter("|"), std::move(content) | ftxui::flex, ftxui::separatorCharacter("|")}),
+      ftxui::hbox({ftxui::text("+"), ftxui::separatorCharacter("-") | ftxui::flex, ftxui::text("+")})
+    });
+  }
+
+  ftxui::Element separator(const char* ascii)
+  {
+    if (config::low_bandwidth)
+      return ftxui::separatorCharacter(ascii);
+    return ftxui::separator();
+  }
+
+  ftxui::BorderStyle border_style() noexcept
+  {
+    return config::low_bandwidth ? ftxui::EMPTY : ftxui::LIGHT;
+  }
 }} // lwcli // decorate
@@ -33,4 +33,13 @@ namespace lwcli { namespace decorate
 {
   ftxui::Element banner(ftxui::Element base);
   ftxui::Element overlay(ftxui::Element base);
+
+  //! `ftxui::window`, or ASCII borders with `config::low_bandwidth`
+  ftxui::Element window(ftxui::Element title, ftxui::Element content);
+
+  //! `ftxui::separator`, or `ascii` repeated with `config::low_bandwidth`
+  ftxui::Element separator(const char* ascii = "-");
+
+  //! Line style for table separators, blank with `config::low_bandwidth`
+  ftxui::BorderStyle border_style() noexcept;
 }} // lwcli // decorate
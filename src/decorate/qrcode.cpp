@@ -0,0 +1,66 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "qrcode.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace lwcli { namespace decorate
+{
+  ftxui::Canvas make_qr_code(const std::vector<std::vector<std::uint8_t>>& raw)
+  {
+    const std::size_t size = raw.size();
+    if (std::numeric_limits<std::size_t>::max() / 4 < size)
+      throw std::runtime_error{"qrcode too large"};
+    if (std::numeric_limits<int>::max() / 4 < size)
+      throw std::runtime_error{"qrcode too large"};
+
+    const std::size_t canvas_size = (size * 2) + ((size % 2) * 2);
+    ftxui::Canvas out{int(canvas_size), int(canvas_size)};
+    for (std::size_t y = 0; y < canvas_size; ++y)
+      for (std::size_t x = 0; x < canvas_size; ++x)
+        out.DrawBlockOff(x, y);
+
+    for (std::size_t y = 0; y < size; ++y)
+    {
+      const auto& row = raw.at(y);
+      for (std::size_t x = 0; x < size; ++x)
+      {
+        if (row.at(x))
+        {
+          const int real_x = x * 2;
+          const int real_y = y * 2;
+          out.DrawBlockOn(real_x, real_y);
+          out.DrawBlockOn(real_x + 1, real_y);
+        }
+      }
+    }
+    return out;
+  }
+}} // lwcli // decorate
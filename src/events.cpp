@@ -33,6 +33,7 @@ namespace lwcli { namespace event
   /* Keep under 15 characters so that libstdc++ and libc++ can use small
   string optmization. */
   const ftxui::Event lock_wallet = ftxui::Event::Special("lwcli.lockw");
+  const ftxui::Event redraw = ftxui::Event::Special("lwcli.redraw");
   const ftxui::Event refresh_wallet = ftxui::Event::Special("lwcli.refresh");
   const ftxui::Event send_async = ftxui::Event::Special("lwcli.sendasync");
 }}
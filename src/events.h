@@ -45,6 +45,7 @@ namespace lwcli { namespace event
   };
 
   extern const ftxui::Event lock_wallet;
+  extern const ftxui::Event redraw; //!< Wakes the UI loop for a new frame only
   extern const ftxui::Event refresh_wallet;
   extern const ftxui::Event send_async;
 
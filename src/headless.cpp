@@ -0,0 +1,289 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "headless.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <lws_frontend.h>
+#include <optional>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <stdexcept>
+#include <termios.h>
+#include <unistd.h>
+
+#include "lwcli_config.h"
+#include "wallet_open.h"
+
+namespace lwcli { namespace headless
+{
+  namespace
+  {
+    using json_writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    struct command_info
+    {
+      char const* const name;
+      const std::size_t args;
+      const bool refresh; //!< needs synced wallet
+    };
+
+    constexpr const command_info commands[] =
+    {
+      {"address", 0, false},
+      {"balance", 0, true},
+      {"history", 0, true},
+      {"send", 2, true}
+    };
+
+    const command_info* find_command(const char* name) noexcept
+    {
+      for (const command_info& info : commands)
+      {
+        if (std::strcmp(info.name, name) == 0)
+          return std::addressof(info);
+      }
+      return nullptr;
+    }
+
+    void string(json_writer& out, const std::string& value)
+    {
+      out.String(value.data(), value.size());
+    }
+
+    int fail(const std::string& error)
+    {
+      rapidjson::StringBuffer buffer;
+      json_writer out{buffer};
+      out.StartObject();
+      out.Key("error");
+      string(out, error);
+      out.EndObject();
+      std::fprintf(stderr, "%s\n", buffer.GetString());
+      return EXIT_FAILURE;
+    }
+
+    void address(json_writer& out, Monero::Wallet& wal, const command& cmd)
+    {
+      out.StartObject();
+      out.Key("account");
+      out.Uint(cmd.account);
+      out.Key("address");
+      string(out, wal.address(cmd.account, 0));
+      out.EndObject();
+    }
+
+    void balance(json_writer& out, Monero::Wallet& wal, const command& cmd)
+    {
+      out.StartObject();
+      out.Key("account");
+      out.Uint(cmd.account);
+      out.Key("balance");
+      out.Uint64(wal.balance(cmd.account));
+      out.Key("unlocked_balance");
+      out.Uint64(wal.unlockedBalance(cmd.account));
+      out.Key("height");
+      out.Uint64(wal.blockChainHeight());
+      out.EndObject();
+    }
+
+    void history(json_writer& out, Monero::Wallet& wal, const command& cmd)
+    {
+      Monero::TransactionHistory* const txes = wal.history();
+      if (!txes)
+        throw std::runtime_error{"unexpected history nullptr"};
+      txes->refresh();
+
+      out.StartArray();
+      for (const Monero::TransactionInfo* tx : txes->getAll())
+      {
+        if (!tx)
+          throw std::runtime_error{"unexpected tx_info nullptr"};
+        if (tx->subaddrAccount() != cmd.account)
+          continue;
+
+        out.StartObject();
+        out.Key("hash");
+        string(out, tx->hash());
+        out.Key("direction");
+        out.String(tx->direction() == Monero::TransactionInfo::Direction_Out ? "out" : "in");
+        out.Key("amount");
+        out.Uint64(tx->amount());
+        out.Key("fee");
+        out.Uint64(tx->fee());
+        out.Key("height");
+        out.Uint64(tx->blockHeight());
+        out.Key("timestamp");
+        out.Int64(tx->timestamp());
+        out.Key("confirmations");
+        out.Uint64(tx->confirmations());
+        out.Key("pending");
+        out.Bool(tx->isPending());
+        out.Key("failed");
+        out.Bool(tx->isFailed());
+        out.Key("payment_id");
+        string(out, tx->paymentId());
+        out.Key("description");
+        string(out, tx->description());
+        out.EndObject();
+      }
+      out.EndArray();
+    }
+
+    bool send(json_writer& out, Monero::Wallet& wal, const command& cmd, std::string& error)
+    {
+      const std::string& address = cmd.args.at(0);
+      const std::optional<std::uint64_t> amount = lwsf::amountFromString(cmd.args.at(1));
+      if (!amount || *amount == 0)
+      {
+        error = "Invalid amount";
+        return false;
+      }
+      if (!lwsf::addressValid(address, wal.nettype()))
+      {
+        error = "Invalid address";
+        return false;
+      }
+
+      const auto dispose = [&wal] (Monero::PendingTransaction* ptr)
+      {
+        if (ptr)
+          wal.disposeTransaction(ptr);
+      };
+      const std::unique_ptr<Monero::PendingTransaction, decltype(dispose)> tx{
+        wal.createTransactionMultDest({address}, {}, std::vector<std::uint64_t>{*amount}, 0 /*mixin_count*/, Monero::PendingTransaction::Priority_Default, cmd.account),
+        dispose
+      };
+
+      if (!tx)
+        throw std::runtime_error{"Unexpected nullptr tx"};
+      if (tx->status() != Monero::PendingTransaction::Status_Ok || !tx->commit())
+      {
+        error = tx->errorString();
+        return false;
+      }
+
+      out.StartObject();
+      out.Key("amount");
+      out.Uint64(tx->amount());
+      out.Key("fee");
+      out.Uint64(tx->fee());
+      out.Key("txids");
+      out.StartArray();
+      for (const std::string& id : tx->txid())
+        string(out, id);
+      out.EndArray();
+      out.EndObject();
+      return true;
+    }
+  } // anonymous
+
+  bool is_command(const char* name, std::size_t* args) noexcept
+  {
+    const command_info* const info = name ? find_command(name) : nullptr;
+    if (info && args)
+      *args = info->args;
+    return info != nullptr;
+  }
+
+  std::string read_password()
+  {
+    termios original{};
+    const bool terminal = isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &original) == 0;
+    if (terminal)
+    {
+      termios silent = original;
+      silent.c_lflag &= ~ECHO;
+      tcsetattr(STDIN_FILENO, TCSANOW, &silent);
+      std::fprintf(stderr, "Password: ");
+    }
+
+    std::string password;
+    std::getline(std::cin, password);
+
+    if (terminal)
+    {
+      tcsetattr(STDIN_FILENO, TCSANOW, &original);
+      std::fprintf(stderr, "\n");
+    }
+    return password;
+  }
+
+  int run(std::shared_ptr<Monero::WalletManager> wm, const std::string& file, const command& cmd)
+  {
+    try
+    {
+      const command_info* const info = find_command(cmd.name.c_str());
+      if (!info || cmd.args.size() != info->args)
+        return fail("Invalid command " + cmd.name);
+      if (!wm)
+        throw std::runtime_error{"lwcli::headless::run given nullptr"};
+      if (file.empty())
+        return fail("--file is required");
+      if (cmd.name == "send" && config::offline)
+        return fail("send is not available with --offline");
+
+      std::string error;
+      std::string password = read_password();
+      const auto wal = prep_wallet(wm, wm->openWallet(file, password, config::network), &error);
+      password.clear();
+      if (!wal)
+        return fail(error);
+
+      if (info->refresh && !config::offline)
+      {
+        if (!init_wallet(*wal, &error))
+          return fail(error);
+        if (!wal->refresh())
+          return fail("Refresh failed: " + wal->errorString());
+      }
+
+      rapidjson::StringBuffer buffer;
+      json_writer out{buffer};
+      if (cmd.name == "address")
+        address(out, *wal, cmd);
+      else if (cmd.name == "balance")
+        balance(out, *wal, cmd);
+      else if (cmd.name == "history")
+        history(out, *wal, cmd);
+      else if (!send(out, *wal, cmd, error))
+        return fail(error);
+
+      std::fwrite(buffer.GetString(), 1, buffer.GetSize(), stdout);
+      std::fputc('\n', stdout);
+    }
+    catch (const std::exception& e)
+    {
+      return fail(e.what());
+    }
+    return EXIT_SUCCESS;
+  }
+}} // lwcli // headless
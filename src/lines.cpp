@@ -0,0 +1,286 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "lines.h"
+
+#include <condition_variable>
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <lws_frontend.h>
+#include <map>
+#include <mutex>
+#include <pthread.h>
+#include <stdexcept>
+#include <thread>
+
+#include "headless.h"
+#include "lwcli_config.h"
+#include "wallet_open.h"
+
+namespace lwcli { namespace lines
+{
+  namespace
+  {
+    //! Wakes the printing loop after each refresh, or on SIGINT/SIGTERM
+    struct waiter final : public Monero::WalletListener
+    {
+      std::mutex sync;
+      std::condition_variable notify;
+      bool pending = true; // print state once before the first refresh
+      bool stop = false;
+
+      void moneySpent(const std::string&, uint64_t) override final {}
+      void moneyReceived(const std::string&, uint64_t) override final {}
+      void unconfirmedMoneyReceived(const std::string&, uint64_t) override final {}
+      void newBlock(uint64_t) override final {}
+      void updated() override final {}
+
+      void refreshed() override final
+      {
+        const std::lock_guard<std::mutex> lock{sync};
+        pending = true;
+        notify.notify_all();
+      }
+    };
+
+    //! Blocks SIGINT/SIGTERM in this and later threads, and waits for them on one thread
+    class signal_watch
+    {
+      waiter& listen_;
+      sigset_t set_;
+      std::thread thread_;
+
+    public:
+      explicit signal_watch(waiter& listen)
+        : listen_(listen), set_(), thread_()
+      {
+        sigemptyset(std::addressof(set_));
+        sigaddset(std::addressof(set_), SIGINT);
+        sigaddset(std::addressof(set_), SIGTERM);
+        if (pthread_sigmask(SIG_BLOCK, std::addressof(set_), nullptr) != 0)
+          throw std::runtime_error{"pthread_sigmask failed"};
+
+        thread_ = std::thread{[this] () {
+          int signal = 0;
+          sigwait(std::addressof(set_), std::addressof(signal));
+
+          const std::lock_guard<std::mutex> lock{listen_.sync};
+          listen_.stop = true;
+          listen_.notify.notify_all();
+        }};
+      }
+
+      ~signal_watch() noexcept
+      {
+        // wake `sigwait` if the loop ended some other way
+        pthread_kill(thread_.native_handle(), SIGTERM);
+        thread_.join();
+        pthread_sigmask(SIG_UNBLOCK, std::addressof(set_), nullptr);
+      }
+    };
+
+    //! Last printed state, only differences are printed
+    struct snapshot
+    {
+      std::string status;
+      std::uint64_t balance = 0;
+      std::uint64_t unlocked = 0;
+      std::map<std::string, std::string> txes; //!< hash -> pending | failed | height
+      bool first = true;
+    };
+
+    void line(const char* format, ...)
+    {
+      const std::time_t now = std::time(nullptr);
+      std::tm expanded{};
+      char date[32] = {0};
+      if (!gmtime_r(std::addressof(now), std::addressof(expanded)) ||
+          !std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::addressof(expanded)))
+        std::strncpy(date, "gmtime fail", sizeof(date) - 1);
+      std::fprintf(stdout, "%s ", date);
+
+      std::va_list args;
+      va_start(args, format);
+      std::vfprintf(stdout, format, args);
+      va_end(args);
+
+      std::fputc('\n', stdout);
+      std::fflush(stdout); // lines should reach `script`/`tmux` logs as they happen
+    }
+
+    std::string tx_state(const Monero::TransactionInfo& tx)
+    {
+      if (tx.isFailed())
+        return "failed";
+      if (tx.isPending())
+        return "pending";
+      return std::to_string(tx.blockHeight());
+    }
+
+    void report(Monero::Wallet& wal, const std::uint32_t account, snapshot& last)
+    {
+      {
+        int code = 0;
+        std::string error;
+        wal.statusWithErrorString(code, error);
+
+        std::string status =
+          wal.connected() == Monero::Wallet::ConnectionStatus_Connected ? "Connected" : "Disconnected";
+        if (code != Monero::Wallet::Status_Ok)
+          status.append(": ").append(error);
+
+        if (status != last.status)
+        {
+          line("status %s", status.c_str());
+          last.status = std::move(status);
+        }
+      }
+
+      const std::uint64_t balance = wal.balance(account);
+      const std::uint64_t unlocked = wal.unlockedBalance(account);
+      if (last.first || balance != last.balance || unlocked != last.unlocked)
+      {
+        line(
+          "balance %s XMR unlocked %s XMR height %llu",
+          lwsf::displayAmount(balance).c_str(),
+          lwsf::displayAmount(unlocked).c_str(),
+          (unsigned long long)wal.blockChainHeight()
+        );
+        last.balance = balance;
+        last.unlocked = unlocked;
+      }
+
+      Monero::TransactionHistory* const history = wal.history();
+      if (!history)
+        throw std::runtime_error{"unexpected history nullptr"};
+      history->refresh();
+
+      std::size_t count = 0;
+      for (const Monero::TransactionInfo* tx : history->getAll())
+      {
+        if (!tx)
+          throw std::runtime_error{"unexpected tx_info nullptr"};
+        if (tx->subaddrAccount() != account)
+          continue;
+
+        ++count;
+        std::string state = tx_state(*tx);
+        const auto existing = last.txes.find(tx->hash());
+        if (existing == last.txes.end())
+        {
+          if (!last.first)
+          {
+            line(
+              "tx %s %s%s XMR fee %s XMR %s %s",
+              tx->direction() == Monero::TransactionInfo::Direction_Out ? "out" : "in",
+              tx->direction() == Monero::TransactionInfo::Direction_Out ? "-" : "",
+              lwsf::displayAmount(tx->amount()).c_str(),
+              lwsf::displayAmount(tx->fee()).c_str(),
+              state.c_str(),
+              tx->hash().c_str()
+            );
+          }
+          last.txes.emplace(tx->hash(), std::move(state));
+        }
+        else if (existing->second != state)
+        {
+          line("tx %s %s", tx->hash().c_str(), state.c_str());
+          existing->second = std::move(state);
+        }
+      }
+
+      // existing history is summarized, not replayed
+      if (last.first)
+        line("history %zu transactions", count);
+      last.first = false;
+    }
+  } // anonymous
+
+  int run(std::shared_ptr<Monero::WalletManager> wm, const std::string& file, const std::uint32_t account)
+  {
+    try
+    {
+      if (!wm)
+        throw std::runtime_error{"lwcli::lines::run given nullptr"};
+      if (file.empty())
+      {
+        std::fprintf(stderr, "--file is required\n");
+        return EXIT_FAILURE;
+      }
+
+      waiter listen{}; // outlives `wal`, which may still be refreshing
+      std::string error;
+      std::string password = headless::read_password();
+      const signal_watch signals{listen}; // before `openWallet` starts threads, so they inherit the mask
+      const auto wal = prep_wallet(wm, wm->openWallet(file, password, config::network), &error);
+      password.clear();
+      if (!wal)
+      {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return EXIT_FAILURE;
+      }
+      if (!init_wallet(*wal, &error))
+      {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return EXIT_FAILURE;
+      }
+
+      wal->setListener(std::addressof(listen));
+      if (!config::offline)
+        wal->startRefresh();
+
+      snapshot last{};
+      std::unique_lock<std::mutex> lock{listen.sync};
+      for (;;)
+      {
+        listen.notify.wait(lock, [&listen] () { return listen.pending || listen.stop; });
+        if (listen.stop)
+          break;
+        listen.pending = false;
+
+        lock.unlock();
+        report(*wal, account, last);
+        lock.lock();
+      }
+      lock.unlock();
+
+      wal->setListener(nullptr);
+      line("stopped");
+    }
+    catch (const std::exception& e)
+    {
+      std::fprintf(stderr, "Fatal Error: %s\n", e.what());
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+}} // lwcli // lines
@@ -54,17 +54,52 @@ namespace lwcli { namespace config
 
   //! Timeout interval for inactivity with open wallet
   constexpr const std::chrono::minutes wallet_timeout{2};
+
+  //! Mouse hover is delivered at most once per interval, newest position wins
+  constexpr const std::chrono::milliseconds hover_interval{50};
+
+  //! Inactivity hides wallet behind password prompt instead of closing it
+  inline bool soft_lock = false;
+
+  //! Opened wallets record per-call latency, viewable from the wallet menu
+  inline bool instrument = false;
+
+  //! Wallets open from the local file only; no server connection or refresh
+  inline bool offline = false;
+
+  //! Capped frame rate, no mouse or animation, ASCII borders for slow links
+  inline bool low_bandwidth = false;
+
+  //! Minimum time between frames with `low_bandwidth`
+  constexpr const std::chrono::milliseconds low_bandwidth_frame{250};
+
+  //! Connections made by the settings "Test" button
+  constexpr const unsigned probe_samples = 5;
+
+  //! Upper bound on the whole settings "Test", not each sample
+  constexpr const std::chrono::seconds probe_timeout{10};
+
+  //! Time between latency probes of every endpoint, when there are several
+  constexpr const std::chrono::seconds failover_interval{30};
+
+  //! Upper bound on one failover probe, so closing the wallet is not held up
+  constexpr const std::chrono::seconds failover_probe_timeout{3};
+
+  //! Percent faster another endpoint must be before the wallet moves to it
+  constexpr const unsigned failover_margin = 25;
+
   namespace server
   { 
     constexpr const std::string_view default_url{"http://127.0.0.1:8080"};
     constexpr const std::chrono::seconds default_refresh_interval{30};
 
+    constexpr const std::string_view fallbacks{"lwcli.ser.alt"};
     constexpr const std::string_view proxy{"lwcli.ser.proxy"};
     constexpr const std::string_view refresh_interval{"lwcli.ser.refr"};
     constexpr const std::string_view ssl{"lwcli.ser.ssl"};
     constexpr const std::string_view url{"lwcli.ser.url"};
 
-    static_assert(verify_sso(proxy, refresh_interval, ssl, url));
+    static_assert(verify_sso(fallbacks, proxy, refresh_interval, ssl, url));
   }
 
   constexpr const std::uint32_t default_major_lookahead = 50;
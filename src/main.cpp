@@ -29,34 +29,57 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <ctime>
 #include <ftxui/component/component.hpp>
+#include <ftxui/component/loop.hpp>
 #include <ftxui/component/screen_interactive.hpp>
+#include <iostream>
 #include <limits>
 #include <lws_frontend.h>
 #include <memory>
-#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
 #include <thread>
+#include <vector>
 
+#include "attach.h"
+#include "components/frame.h"
 #include "events.h"
+#include "headless.h"
+#include "lines.h"
 #include "lwcli_config.h"
+#include "mock/wallet.h"
+#include "profile.h"
+#include "server.h"
+#include "timer.h"
+#include "trace.h"
 #include "util.h"
 #include "views/manager.h"
 
 namespace
 {
-  enum class rpc { lws = 0, monerod };
+  enum class rpc { lws = 0, monerod, mock };
   struct program
   {
+    std::string detach;
     std::string file;
-    std::chrono::seconds wallet_timeout = lwcli::config::wallet_timeout;
+    std::string profile;
+    std::string serve;
+    std::string stall_log;
+    std::string trace;
+    std::chrono::milliseconds stall_limit{250};
+    std::optional<std::chrono::seconds> wallet_timeout; //!< Else profile, else config
+    lwcli::headless::command exec;
+    lwcli::mock::config mock;
     rpc backend = rpc::lws;
-    // network is in static memory
+    // network, lock, instrument, low bandwidth and offline modes are in static memory
     bool failed = false;
+    bool lines = false;
+    bool wire_stats = false;
   };
 
   typedef const char**(*argument_handler)(program&, const char*[]);
@@ -86,6 +109,26 @@ namespace
     return ++argv;
   }
 
+  const char** handle_account(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      fprintf(stderr, "Missing argument for --account\n");
+      return nullptr;
+    }
+
+    const auto value = lwcli::from_string(argv[0]);
+    if (!value || std::numeric_limits<std::uint32_t>::max() < *value)
+    {
+      prog.failed = true;
+      fprintf(stderr, "Invalid value for --account\n");
+      return nullptr;
+    }
+
+    prog.exec.account = std::uint32_t(*value);
+    return ++argv;
+  }
+
   const char** handle_backend(program& prog, const char* argv[])
   {
     if (!argv || !argv[0])
@@ -98,6 +141,8 @@ namespace
       prog.backend = rpc::lws;
     else if (std::strcmp("monerod", argv[0]) == 0)
       prog.backend = rpc::monerod;
+    else if (std::strcmp("mock", argv[0]) == 0)
+      prog.backend = rpc::mock;
     else
     {
       prog.failed = true;
@@ -107,10 +152,100 @@ namespace
 
     return ++argv;
   }
+  const char** handle_detach(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.detach, "detach", argv);
+  }
+  const char** handle_exec(program& prog, const char* argv[])
+  {
+    std::size_t args = 0;
+    if (!argv || !argv[0] || !lwcli::headless::is_command(argv[0], &args))
+    {
+      prog.failed = true;
+      fprintf(stderr, "--exec value is not valid\n");
+      return nullptr;
+    }
+    if (!prog.exec.name.empty())
+    {
+      prog.failed = true;
+      fprintf(stderr, "Argument --exec listed twice\n");
+      return nullptr;
+    }
+
+    prog.exec.name = argv[0];
+    for (++argv; args; --args, ++argv)
+    {
+      if (!argv[0])
+      {
+        prog.failed = true;
+        fprintf(stderr, "Missing argument for --exec %s\n", prog.exec.name.c_str());
+        return nullptr;
+      }
+      prog.exec.args.push_back(argv[0]);
+    }
+    return argv;
+  }
   const char** handle_file(program& prog, const char* argv[])
   {
     return basic_handler(prog, prog.file, "file", argv);
   }
+  const char** handle_instrument(program&, const char* argv[])
+  {
+    lwcli::config::instrument = true;
+    return argv;
+  }
+  const char** handle_low_bandwidth(program&, const char* argv[])
+  {
+    lwcli::config::low_bandwidth = true;
+    return argv;
+  }
+  const char** handle_lines(program& prog, const char* argv[])
+  {
+    prog.lines = true;
+    return argv;
+  }
+  const char** handle_lock(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      fprintf(stderr, "Missing argument for --lock\n");
+      return nullptr;
+    }
+
+    if (std::strcmp("soft", argv[0]) == 0)
+      lwcli::config::soft_lock = true;
+    else if (std::strcmp("close", argv[0]) == 0)
+      lwcli::config::soft_lock = false;
+    else
+    {
+      prog.failed = true;
+      fprintf(stderr, "--lock value is not valid\n");
+      return nullptr;
+    }
+
+    return ++argv;
+  }
+  const char** handle_mock(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      fprintf(stderr, "Missing argument for --mock\n");
+      return nullptr;
+    }
+
+    const auto config = lwcli::mock::parse(argv[0]);
+    if (!config)
+    {
+      prog.failed = true;
+      fprintf(stderr, "Invalid value for --mock\n");
+      return nullptr;
+    }
+
+    prog.mock = *config;
+    prog.backend = rpc::mock;
+    return ++argv;
+  }
+
   const char** handle_network(program& prog, const char* argv[])
   {
     if (!argv || !argv[0])
@@ -134,6 +269,51 @@ namespace
 
     return ++argv;
   }
+  const char** handle_serve(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.serve, "serve", argv);
+  }
+  const char** handle_trace(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.trace, "trace", argv);
+  }
+  const char** handle_stall_log(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.stall_log, "stall-log", argv);
+  }
+  const char** handle_stall_ms(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      fprintf(stderr, "Missing argument for --stall-ms\n");
+      return nullptr;
+    }
+
+    const auto value = lwcli::from_string(argv[0]);
+    if (!value || !*value || std::numeric_limits<std::chrono::milliseconds::rep>::max() < *value)
+    {
+      prog.failed = true;
+      fprintf(stderr, "Invalid value for --stall-ms\n");
+      return nullptr;
+    }
+
+    prog.stall_limit = std::chrono::milliseconds{*value};
+    return ++argv;
+  }
+  const char** handle_offline(program&, const char* argv[])
+  {
+    lwcli::config::offline = true;
+    return argv;
+  }
+  const char** handle_profile(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.profile, "profile", argv);
+  }
+  const char** handle_wire_stats(program& prog, const char* argv[])
+  {
+    prog.wire_stats = true;
+    return argv;
+  }
   const char** handle_timeout(program& prog, const char* argv[])
   {
     if (!argv || !argv[0])
@@ -156,12 +336,31 @@ namespace
   constexpr const argument process_args[] =
   {
     {nullptr, "help", "\t\t\tList help", 'h'},
+    {handle_account, "account", "\tindex\t\t\tAccount used by --exec and --lines. 0 is default", 'a'},
 #ifdef LWCLI_WALLET2_ENABLED
-    {handle_backend, "backend", "\tlws | monerod\t\tlws = default , selects rpc backend", 'b'},
+    {handle_backend, "backend", "\tlws | monerod | mock\tlws = default , selects rpc backend", 'b'},
+#else
+    {handle_backend, "backend", "\tlws | mock\t\tlws = default , selects rpc backend", 'b'},
 #endif
+    {handle_detach, "detach", "\t[socket path]\t\tRun TUI in a background session and attach to it. Ctrl-\\ detaches", 'd'},
+    {handle_exec, "exec", "\tbalance | history | address | send [address] [amount]\tRun without TUI, JSON output. Password read from stdin", 'x'},
     {handle_file, "file", "\t[file path]\t\tDefaults to home directory. Auto-fills TUI value on launch", 'f'},
+    {handle_instrument, "instrument", "\t\t\tRecord latency of every wallet call. Shown with [i] in wallet view", 'i'},
+    {handle_lines, "lines", "\t\t\tAppend a line per wallet change instead of a TUI. --file password read from stdin", 'o'},
+    {handle_low_bandwidth, "low-bandwidth", "\t\t\tFewer frames, no mouse or animation, ASCII borders. For slow SSH/Tor", 'L'},
+    {handle_lock, "lock", "\tsoft | close\t\tsoft = keep wallet open and syncing when locked. close is default", 'l'},
+    {handle_mock, "mock", "\tseed=N,txs=N,accounts=N,subaddresses=N,latency_us=N\tGenerated wallets for profiling. Implies --backend mock", 'm'},
     {handle_network, "network", "\tmain | stage | test\tSelects wallet network type. main is default.", 'n'},
-    {handle_timeout, "timeout", "\tseconds\tClose wallet after inactivity. Default 120", 't'}
+    {handle_offline, "offline", "\t\t\tOpen wallets from the local file only. No server, refresh or send", 'O'},
+    {handle_profile, "profile", "\tname\t\t\tSection of ~/.config/lwcli/profiles used for new wallets. [default] otherwise", 'P'},
+    {handle_serve, "serve", "\t[socket path]\t\tJSON-RPC server on unix socket, no TUI. --file password read from stdin", 's'},
+    {handle_stall_log, "stall-log", "\t[file path]\t\tAppend UI freezes longer than --stall-ms, with the blocking operation", 'w'},
+    {handle_stall_ms, "stall-ms", "\tmilliseconds\tThreshold for --stall-log. Default 250", 'W'},
+    {handle_timeout, "timeout", "\tseconds\tClose wallet after inactivity. Default 120", 't'},
+    {handle_wire_stats, "wire-stats", "\t\t\tPrint bytes written to the terminal per minute on exit", 'B'},
+#ifdef LWCLI_TRACE_ENABLED
+    {handle_trace, "trace", "\t[file path]\t\tWrite Chrome trace_event JSON of frames and wallet calls on exit", 'T'}
+#endif
   };
 
   template<typename F>
@@ -198,82 +397,170 @@ namespace
   struct screen_state
   {
     std::atomic<std::chrono::steady_clock::time_point::duration::rep> last_event;
+    std::atomic<std::chrono::steady_clock::time_point::duration::rep> busy_since; //!< 0 when idle
     ftxui::ScreenInteractive screen;
-    std::mutex sync;
-    std::condition_variable notify;
-    bool shutdown;
 
     screen_state()
       : last_event(std::chrono::steady_clock::now().time_since_epoch().count()),
-        screen(ftxui::ScreenInteractive::Fullscreen()),
-        sync(),
-        notify(),
-        shutdown(false)
+        busy_since(0),
+        screen(ftxui::ScreenInteractive::Fullscreen())
     {}
   };
 
+  //! Sleeps on the shared timer queue until `wallet_timeout` after the last user event
   struct watch_inactivity
   {
     screen_state& state;
-    std::thread watcher;
     const std::chrono::seconds wallet_timeout;
+    lwcli::timer::id deadline;
+
+    lwcli::timer::clock::time_point check()
+    {
+      const lwcli::timer::clock::time_point last_event{
+        lwcli::timer::clock::duration{state.last_event.load()}
+      };
+
+      const auto now = lwcli::timer::clock::now();
+      if (now - last_event < wallet_timeout)
+        return last_event + wallet_timeout;
+
+      state.last_event = now.time_since_epoch().count();
+      state.screen.PostEvent(lwcli::event::lock_wallet);
+      return now + wallet_timeout;
+    }
 
     watch_inactivity(screen_state& st, std::chrono::seconds wt)
-      : state(st), watcher(), wallet_timeout(wt)
+      : state(st), wallet_timeout(wt), deadline(0)
     {
-      watcher = std::thread([this] () {
-        std::unique_lock lock{state.sync};
-        while (!state.shutdown)
-        {
-          const std::chrono::steady_clock::time_point last_event{
-            std::chrono::steady_clock::time_point::duration{state.last_event.load()}
-          };
-
-          const auto now = std::chrono::steady_clock::now();
-          auto time_diff = now - last_event;
-          if (wallet_timeout <= time_diff)
-          {
-            state.last_event = now.time_since_epoch().count();
-            state.screen.PostEvent(lwcli::event::lock_wallet);
-            time_diff = std::chrono::seconds{0};
-          }
-
-          state.notify.wait_for(lock, (wallet_timeout - time_diff), [this] () {
-            return state.shutdown;
-          });
-        }
-      });
+      deadline = lwcli::timer::schedule(
+        lwcli::timer::clock::now() + wallet_timeout, [this] () { return check(); }
+      );
     }
 
-    ~watch_inactivity() noexcept // abort if double exception
+    ~watch_inactivity() noexcept
     {
-      std::unique_lock lock{state.sync};
-      state.shutdown = true;
-      state.notify.notify_one();
-      lock.unlock();
-      if (watcher.joinable())
-        watcher.join();
+      lwcli::timer::cancel(deadline);
     }
   };
-}
 
-int main(int, const char* argv[])
-{
-  screen_state state{};
-  try
+  //! Marks when the UI thread enters the component tree, so stalls can be detected
+  class watch_busy final : public ftxui::ComponentBase
   {
-    if (!argv)
+    screen_state& state_;
+    const ftxui::Component child_;
+
+    struct busy
     {
-      fprintf(stderr, "No process name\n");
-      return -1;
+      screen_state& state;
+
+      explicit busy(screen_state& st) noexcept
+        : state(st)
+      {
+        state.busy_since = std::chrono::steady_clock::now().time_since_epoch().count();
+      }
+
+      ~busy() noexcept
+      {
+        state.busy_since = 0;
+      }
+    };
+
+    bool Focusable() const override final { return child_->Focusable(); }
+    ftxui::Component ActiveChild() override final { return child_; }
+
+  public:
+    explicit watch_busy(screen_state& state, ftxui::Component child)
+      : ftxui::ComponentBase(), state_(state), child_(std::move(child))
+    {
+      Add(child_);
     }
 
-    ++argv;
-    program prog{};
-    while (argv = process_argument(prog, argv));
-    if (prog.failed)
-      return -1;
+    bool OnEvent(ftxui::Event event) override final
+    {
+      const busy mark{state_};
+      return child_->OnEvent(std::move(event));
+    }
+
+    ftxui::Element OnRender() override final
+    {
+      const busy mark{state_};
+      return child_->Render();
+    }
+  };
+
+  //! Logs when the UI thread has been inside the component tree for too long
+  struct watch_stalls
+  {
+    using rep = std::chrono::steady_clock::time_point::duration::rep;
+
+    screen_state& state;
+    std::FILE* const log;
+    const std::chrono::milliseconds limit;
+    rep reported;
+    lwcli::timer::id poll;
+
+    static void write_time(std::FILE* log)
+    {
+      const auto now = std::chrono::system_clock::now();
+      const std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+      const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+
+      std::tm expanded{};
+      char buf[32] = {0};
+      if (!gmtime_r(std::addressof(seconds), std::addressof(expanded)) ||
+          !std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", std::addressof(expanded)))
+        std::strncpy(buf, "gmtime fail", sizeof(buf) - 1);
+      fprintf(log, "%s.%03dZ ", buf, int(millis));
+    }
+
+    lwcli::timer::clock::time_point check()
+    {
+      const rep since = state.busy_since.load();
+      const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::time_point::duration{since}};
+      const auto now = std::chrono::steady_clock::now();
+      const auto elapsed = now - start;
+
+      if (since && since != reported && limit <= elapsed)
+      {
+        // read while still stalled, the operation is gone once the UI returns
+        const char* operation = lwcli::trace::ui_operation.load(std::memory_order_relaxed);
+        reported = since;
+
+        write_time(log);
+        fprintf(
+          log, "UI stalled %lldms in %s\n",
+          (long long)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(),
+          operation ? operation : "unknown operation"
+        );
+        std::fflush(log);
+      }
+
+      return now + limit / 4;
+    }
+
+    //! Polls only with `--stall-log`; the idle path has no timer
+    watch_stalls(screen_state& st, std::FILE* lg, std::chrono::milliseconds lm)
+      : state(st), log(lg), limit(lm), reported(0), poll(0)
+    {
+      if (log)
+        poll = lwcli::timer::schedule(std::chrono::steady_clock::now() + limit / 4, [this] () { return check(); });
+    }
+
+    ~watch_stalls() noexcept
+    {
+      if (poll)
+        lwcli::timer::cancel(poll);
+    }
+  };
 
+  //! Flushes spans on every return path of `main`
+  struct stop_trace
+  {
+    ~stop_trace() { lwcli::trace::stop(); }
+  };
+
+  std::shared_ptr<Monero::WalletManager> get_wallet_manager(const program& prog)
+  {
     std::shared_ptr<Monero::WalletManager> wm;
     switch (prog.backend)
     {
@@ -286,32 +573,197 @@ int main(int, const char* argv[])
         wm.reset(Monero::WalletManagerFactory::getWalletManager());
 #endif
         break;
+      case rpc::mock:
+        wm.reset(lwcli::mock::wallet_manager(prog.mock));
+        break;
     }
+    return wm;
+  }
 
-    auto window = ftxui::CatchEvent(lwcli::view::manager(std::move(wm), std::move(prog.file)), [&] (ftxui::Event event)
+  //! \return Copy of `argv` without the --detach option, for the session process.
+  std::vector<const char*> session_args(const char* argv[])
+  {
+    std::vector<const char*> out;
+    for (; argv && argv[0]; ++argv)
     {
-      if (event != lwcli::event::refresh_wallet)
-        state.last_event = std::chrono::steady_clock::now().time_since_epoch().count();
-      if (event == ftxui::Event::CtrlC)
+      if (std::strcmp(argv[0], "--detach") == 0 || std::strcmp(argv[0], "-d") == 0)
       {
-        state.screen.ExitLoopClosure()();
-        return true;
+        if (!argv[1])
+          break;
+        ++argv;
       }
-      return false;
-    });
+      else
+        out.push_back(argv[0]);
+    }
+    out.push_back(nullptr);
+    return out;
+  }
+
+  //! Counts bytes FTXUI writes to `std::cout`, reported on destruction
+  class count_output final : public std::streambuf
+  {
+    std::streambuf* const inner_;
+    const std::chrono::steady_clock::time_point start_;
+    std::uint64_t bytes_;
+
+  protected:
+    int_type overflow(const int_type c) override final
+    {
+      if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+      ++bytes_;
+      return inner_->sputc(traits_type::to_char_type(c));
+    }
 
-    const watch_inactivity watch{state, prog.wallet_timeout};
-    state.screen.Loop(window);
+    std::streamsize xsputn(const char_type* s, const std::streamsize count) override final
+    {
+      bytes_ += count;
+      return inner_->sputn(s, count);
+    }
+
+    int sync() override final { return inner_->pubsync(); }
+
+  public:
+    count_output()
+      : std::streambuf(),
+        inner_(std::cout.rdbuf(this)),
+        start_(std::chrono::steady_clock::now()),
+        bytes_(0)
+    {}
+
+    ~count_output() noexcept
+    {
+      std::cout.rdbuf(inner_);
+      const std::chrono::duration<double, std::ratio<60>> elapsed = std::chrono::steady_clock::now() - start_;
+      fprintf(
+        stderr, "Wrote %llu bytes to terminal in %.2f minutes (%.0f bytes/min)\n",
+        (unsigned long long)bytes_, elapsed.count(), elapsed.count() ? bytes_ / elapsed.count() : 0.0
+      );
+    }
+  };
+
+  //! FTXUI `Loop`, but frames are batched `config::low_bandwidth_frame` apart
+  void run_capped(ftxui::ScreenInteractive& screen, ftxui::Component window)
+  {
+    ftxui::Loop loop{&screen, std::move(window)};
+    while (!loop.HasQuitted())
+    {
+      loop.RunOnceBlocking(); // all queued events, then one frame
+      std::this_thread::sleep_for(lwcli::config::low_bandwidth_frame);
+    }
   }
-  catch (const lwcli::event::close&)
-  {}
-  catch (const std::exception& e)
+
+  int run_tui(program&& prog)
   {
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> stall_log{nullptr, &std::fclose};
+    if (!prog.stall_log.empty())
+    {
+      stall_log.reset(std::fopen(prog.stall_log.c_str(), "a"));
+      if (!stall_log)
+      {
+        fprintf(stderr, "Unable to open --stall-log file\n");
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::optional<count_output> wire_stats;
+    if (prog.wire_stats)
+      wire_stats.emplace();
+
+    lwcli::trace::ui_thread = true;
+    screen_state state{};
+    if (lwcli::config::low_bandwidth)
+      state.screen.TrackMouse(false);
+    try
+    {
+      auto window = ftxui::CatchEvent(lwcli::view::manager(get_wallet_manager(prog), std::move(prog.file)), [&] (ftxui::Event event)
+      {
+        if (event == lwcli::event::redraw)
+          return true; // frame only, not user activity
+        if (event != lwcli::event::refresh_wallet)
+          state.last_event = std::chrono::steady_clock::now().time_since_epoch().count();
+        if (event == ftxui::Event::CtrlC)
+        {
+          state.screen.ExitLoopClosure()();
+          return true;
+        }
+        return false;
+      });
+
+      watch_inactivity watch{state, prog.wallet_timeout.value_or(lwcli::config::wallet_timeout)};
+      watch_stalls stalls{state, stall_log.get(), prog.stall_limit};
+      window = lwcli::component::throttle_hover(lwcli::component::frame_cache(std::move(window)), lwcli::config::hover_interval);
+      window = std::make_shared<watch_busy>(state, std::move(window));
+      if (lwcli::config::low_bandwidth)
+        run_capped(state.screen, std::move(window));
+      else
+        state.screen.Loop(std::move(window));
+    }
+    catch (const lwcli::event::close&)
+    {}
+    catch (const std::exception& e)
+    {
+      state.screen.Clear();
+      fprintf(stderr, "Fatal Error: %s\n", e.what());
+      return EXIT_FAILURE;
+    }
+
     state.screen.Clear();
+    return EXIT_SUCCESS;
+  }
+}
+
+int main(int, const char* argv[])
+{
+  try
+  {
+    if (!argv)
+    {
+      fprintf(stderr, "No process name\n");
+      return -1;
+    }
+
+    const char** const original = argv;
+    ++argv;
+    program prog{};
+    while (argv = process_argument(prog, argv));
+    if (prog.failed)
+      return -1;
+
+    if (1 < (!prog.detach.empty() + !prog.exec.name.empty() + !prog.serve.empty() + prog.lines))
+    {
+      fprintf(stderr, "--detach, --exec, --lines and --serve cannot be combined\n");
+      return -1;
+    }
+
+    if (!prog.detach.empty())
+      return lwcli::attach::session(prog.detach, session_args(original).data());
+
+    // detached session traces in the session process, not here
+    if (!prog.trace.empty() && !lwcli::trace::start(prog.trace))
+    {
+      fprintf(stderr, "Unable to open --trace file\n");
+      return -1;
+    }
+    const stop_trace trace_guard{};
+
+    // headless modes skip all terminal setup
+    if (!prog.serve.empty())
+      return lwcli::server::run(get_wallet_manager(prog), prog.serve, prog.file);
+    if (!prog.exec.name.empty())
+      return lwcli::headless::run(get_wallet_manager(prog), prog.file, prog.exec);
+    if (prog.lines)
+      return lwcli::lines::run(get_wallet_manager(prog), prog.file, prog.exec.account);
+
+    const lwcli::profile::settings profile = lwcli::profile::load(prog.profile);
+    lwcli::config::profile = profile.wallet;
+    if (!prog.wallet_timeout)
+      prog.wallet_timeout = profile.timeout;
+    return run_tui(std::move(prog));
+  }
+  catch (const std::exception& e)
+  {
     fprintf(stderr, "Fatal Error: %s\n", e.what());
-    return EXIT_FAILURE;
   }
- 
-  state.screen.Clear();
-  return EXIT_SUCCESS;  
+  return EXIT_FAILURE;
 }
@@ -0,0 +1,939 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "wallet.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <lws_frontend.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util.h"
+
+namespace lwcli { namespace mock
+{
+  namespace
+  {
+    constexpr const std::uint64_t base_height = 2000000;
+    constexpr const std::uint64_t base_timestamp = 1575072000;
+    constexpr const std::uint64_t blocks_per_tx = 3;
+
+    constexpr const char base58[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    constexpr const char hex[] = "0123456789abcdef";
+
+    std::uint64_t splitmix(std::uint64_t x) noexcept
+    {
+      x += 0x9e3779b97f4a7c15;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+      return x ^ (x >> 31);
+    }
+
+    std::string to_hex(const std::array<std::uint8_t, 32>& bytes)
+    {
+      std::string out;
+      out.resize(bytes.size() * 2);
+      for (std::size_t i = 0; i < bytes.size(); ++i)
+      {
+        out[i * 2] = hex[bytes[i] >> 4];
+        out[i * 2 + 1] = hex[bytes[i] & 0x0f];
+      }
+      return out;
+    }
+
+    std::optional<std::array<std::uint8_t, 32>> from_hex(const std::string& str) noexcept
+    {
+      const auto nibble = [] (const char c) -> int
+      {
+        if ('0' <= c && c <= '9')
+          return c - '0';
+        if ('a' <= c && c <= 'f')
+          return c - 'a' + 10;
+        return -1;
+      };
+
+      std::array<std::uint8_t, 32> out{};
+      if (str.size() != out.size() * 2)
+        return std::nullopt;
+      for (std::size_t i = 0; i < out.size(); ++i)
+      {
+        const int high = nibble(str[i * 2]);
+        const int low = nibble(str[i * 2 + 1]);
+        if (high < 0 || low < 0)
+          return std::nullopt;
+        out[i] = std::uint8_t((high << 4) | low);
+      }
+      return out;
+    }
+
+    std::string random_hex(std::mt19937_64& rng)
+    {
+      std::array<std::uint8_t, 32> bytes{};
+      for (std::uint8_t& byte : bytes)
+        byte = std::uint8_t(rng());
+      return to_hex(bytes);
+    }
+
+    //! Compact generated tx, strings are built on demand like a real backend
+    class tx_info final : public Monero::TransactionInfo
+    {
+      const config* const cfg_;
+      const std::atomic<std::uint64_t>* const height_;
+      const std::array<std::uint8_t, 32> hash_;
+      std::string note_;
+      const std::uint64_t amount_;
+      const std::uint64_t fee_;
+      const std::uint64_t block_;
+      const std::uint32_t account_;
+      const std::uint32_t minor_;
+      const bool out_;
+      const bool pending_;
+
+    public:
+      tx_info(const config& cfg, const std::atomic<std::uint64_t>& height, const std::array<std::uint8_t, 32>& hash, std::uint64_t amount, std::uint64_t fee, std::uint64_t block, std::uint32_t account, std::uint32_t minor, bool out, bool pending)
+        : cfg_(std::addressof(cfg)),
+          height_(std::addressof(height)),
+          hash_(hash),
+          note_(),
+          amount_(amount),
+          fee_(fee),
+          block_(block),
+          account_(account),
+          minor_(minor),
+          out_(out),
+          pending_(pending)
+      {}
+
+      const std::array<std::uint8_t, 32>& raw_hash() const noexcept { return hash_; }
+      void set_note(const std::string& note) { note_ = note; }
+      bool is_out() const noexcept { return out_; }
+
+      int direction() const override { return out_ ? Direction_Out : Direction_In; }
+      bool isPending() const override { return pending_; }
+      bool isFailed() const override { return false; }
+      bool isCoinbase() const override { return false; }
+      std::uint64_t amount() const override { return amount_; }
+      std::uint64_t fee() const override { return out_ ? fee_ : 0; }
+      std::uint64_t blockHeight() const override { return pending_ ? 0 : block_; }
+      std::string description() const override { return note_; }
+      std::set<std::uint32_t> subaddrIndex() const override { return {minor_}; }
+      std::uint32_t subaddrAccount() const override { return account_; }
+      std::string label() const override { return {}; }
+      std::uint64_t confirmations() const override
+      {
+        const std::uint64_t height = *height_;
+        return pending_ || height < block_ ? 0 : height - block_;
+      }
+      std::uint64_t unlockTime() const override { return 0; }
+      std::string hash() const override { return to_hex(hash_); }
+      std::time_t timestamp() const override { return std::time_t(base_timestamp + (block_ - base_height) * 120); }
+      std::string paymentId() const override { return "0000000000000000"; }
+      const std::vector<Transfer>& transfers() const override
+      {
+        static const std::vector<Transfer> none{};
+        return none;
+      }
+    };
+
+    class wallet_;
+
+    class history_ final : public Monero::TransactionHistory
+    {
+      wallet_* const wal_;
+      std::vector<Monero::TransactionInfo*> all_;
+
+    public:
+      explicit history_(wallet_* wal)
+        : wal_(wal), all_()
+      {}
+
+      int count() const override { return int(all_.size()); }
+      Monero::TransactionInfo* transaction(int index) const override;
+      Monero::TransactionInfo* transaction(const std::string& id) const override;
+      std::vector<Monero::TransactionInfo*> getAll() const override { return all_; }
+      void refresh() override;
+      void setTxNote(const std::string& txid, const std::string& note) override;
+    };
+
+    class subaddress_ final : public Monero::Subaddress
+    {
+      wallet_* const wal_;
+      std::vector<std::unique_ptr<Monero::SubaddressRow>> rows_;
+
+    public:
+      explicit subaddress_(wallet_* wal)
+        : wal_(wal), rows_()
+      {}
+
+      std::vector<Monero::SubaddressRow*> getAll() const override
+      {
+        std::vector<Monero::SubaddressRow*> out;
+        out.reserve(rows_.size());
+        for (const auto& row : rows_)
+          out.push_back(row.get());
+        return out;
+      }
+      void addRow(std::uint32_t accountIndex, const std::string& label) override;
+      void setLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label) override;
+      void refresh(std::uint32_t accountIndex) override;
+    };
+
+    class accounts_ final : public Monero::SubaddressAccount
+    {
+      wallet_* const wal_;
+      std::vector<std::unique_ptr<Monero::SubaddressAccountRow>> rows_;
+
+    public:
+      explicit accounts_(wallet_* wal)
+        : wal_(wal), rows_()
+      {}
+
+      std::vector<Monero::SubaddressAccountRow*> getAll() const override
+      {
+        std::vector<Monero::SubaddressAccountRow*> out;
+        out.reserve(rows_.size());
+        for (const auto& row : rows_)
+          out.push_back(row.get());
+        return out;
+      }
+      void addRow(const std::string& label) override;
+      void setLabel(std::uint32_t accountIndex, const std::string& label) override;
+      void refresh() override;
+    };
+
+    class pending_ final : public Monero::PendingTransaction
+    {
+      wallet_* const wal_;
+      const std::vector<std::string> txid_;
+      const std::uint64_t amount_;
+      const std::uint64_t fee_;
+      const std::uint32_t account_;
+
+    public:
+      pending_(wallet_* wal, std::string txid, std::uint64_t amount, std::uint64_t fee, std::uint32_t account)
+        : wal_(wal), txid_({std::move(txid)}), amount_(amount), fee_(fee), account_(account)
+      {}
+
+      int status() const override { return Status_Ok; }
+      std::string errorString() const override { return {}; }
+      bool commit(const std::string& filename, bool overwrite) override;
+      std::uint64_t amount() const override { return amount_; }
+      std::uint64_t dust() const override { return 0; }
+      std::uint64_t fee() const override { return fee_; }
+      std::vector<std::string> txid() const override { return txid_; }
+      std::uint64_t txCount() const override { return 1; }
+      std::vector<std::uint32_t> subaddrAccount() const override { return {account_}; }
+      std::vector<std::set<std::uint32_t>> subaddrIndices() const override { return {{0}}; }
+      std::string multisigSignData() override { return {}; }
+      void signMultisigTx() override {}
+      std::vector<std::string> signersKeys() const override { return {}; }
+      std::vector<std::string> hex() const override { return {}; }
+      std::vector<std::string> txKey() const override { return {}; }
+    };
+
+    //! Running sums, so `balance()` does not scan every tx
+    struct totals
+    {
+      std::uint64_t in = 0;
+      std::uint64_t out = 0;
+    };
+
+    class wallet_ final : public Monero::Wallet
+    {
+      friend class history_;
+      friend class subaddress_;
+      friend class accounts_;
+      friend class pending_;
+
+      const config cfg_;
+      const std::string path_;
+      const Monero::NetworkType nettype_;
+      std::string password_;
+      mutable std::mutex sync_;
+      std::deque<tx_info> txes_; // deque keeps pointers stable on append
+      std::vector<std::size_t> by_hash_;
+      std::vector<totals> totals_; //!< Per account, kept with `txes_`
+      std::vector<std::vector<std::string>> labels_;
+      std::map<std::string, std::string> attributes_;
+      std::atomic<std::uint64_t> height_; // refresher writes, UI thread reads
+      std::mt19937_64 rng_;
+      history_ tx_history_;
+      subaddress_ subaddresses_;
+      accounts_ subaccounts_;
+      std::atomic<Monero::WalletListener*> listener_;
+      std::condition_variable notify_;
+      std::thread refresher_;
+      std::atomic<int> refresh_interval_; // UI thread writes, refresher reads
+      bool stop_;
+      std::atomic<bool> connected_;
+
+      void delay() const
+      {
+        if (cfg_.latency.count())
+          std::this_thread::sleep_for(cfg_.latency);
+      }
+
+      void index_hashes()
+      {
+        by_hash_.resize(txes_.size());
+        for (std::size_t i = 0; i < by_hash_.size(); ++i)
+          by_hash_[i] = i;
+        std::sort(by_hash_.begin(), by_hash_.end(), [this] (const std::size_t lhs, const std::size_t rhs) {
+          return txes_[lhs].raw_hash() < txes_[rhs].raw_hash();
+        });
+      }
+
+      //! Inserts the last tx of `txes_` into the sorted `by_hash_`
+      void index_last()
+      {
+        const std::size_t last = txes_.size() - 1;
+        const auto position = std::upper_bound(by_hash_.begin(), by_hash_.end(), last, [this] (const std::size_t lhs, const std::size_t rhs) {
+          return txes_[lhs].raw_hash() < txes_[rhs].raw_hash();
+        });
+        by_hash_.insert(position, last);
+      }
+
+      //! Adds `tx` to the running balance of its account
+      void count(const tx_info& tx)
+      {
+        const std::uint32_t account = tx.subaddrAccount();
+        if (totals_.size() <= account)
+          totals_.resize(std::size_t(account) + 1);
+        if (tx.is_out())
+          totals_[account].out += tx.amount() + tx.fee();
+        else
+          totals_[account].in += tx.amount();
+      }
+
+      std::array<std::uint8_t, 32> random_hash()
+      {
+        std::array<std::uint8_t, 32> out{};
+        for (std::uint8_t& byte : out)
+          byte = std::uint8_t(rng_());
+        return out;
+      }
+
+      void generate()
+      {
+        const std::uint32_t accounts = std::max<std::uint32_t>(1, cfg_.accounts);
+        const std::uint32_t subaddresses = std::max<std::uint32_t>(1, cfg_.subaddresses);
+
+        labels_.resize(accounts);
+        for (std::uint32_t major = 0; major < accounts; ++major)
+        {
+          labels_[major].resize(subaddresses);
+          labels_[major][0] = major ? "Account " + std::to_string(major) : "Primary account";
+        }
+
+        // mostly incoming, so generated balances stay positive
+        std::uniform_int_distribution<std::uint64_t> amounts{1000000000, 10000000000000};
+        std::uniform_int_distribution<std::uint64_t> fees{20000000, 60000000};
+        for (std::uint64_t i = 0; i < cfg_.txs; ++i)
+        {
+          const bool out = rng_() % 4 == 0;
+          const std::uint64_t amount = amounts(rng_) / (out ? 4 : 1);
+          txes_.emplace_back(
+            cfg_, height_, random_hash(), amount, fees(rng_), base_height + i * blocks_per_tx,
+            std::uint32_t(rng_() % accounts), std::uint32_t(out ? 0 : rng_() % subaddresses), out, false
+          );
+          count(txes_.back());
+        }
+        height_ = base_height + cfg_.txs * blocks_per_tx + 10;
+        index_hashes();
+      }
+
+      const tx_info* find_tx(const std::string& id) const
+      {
+        const auto hash = from_hex(id);
+        if (!hash)
+          return nullptr;
+        const auto match = std::lower_bound(by_hash_.begin(), by_hash_.end(), *hash, [this] (const std::size_t lhs, const std::array<std::uint8_t, 32>& rhs) {
+          return txes_[lhs].raw_hash() < rhs;
+        });
+        if (match == by_hash_.end() || txes_[*match].raw_hash() != *hash)
+          return nullptr;
+        return std::addressof(txes_[*match]);
+      }
+
+      std::uint64_t compute_balance(const std::uint32_t account) const
+      {
+        if (totals_.size() <= account)
+          return 0;
+        const totals& current = totals_[account];
+        return current.out < current.in ? current.in - current.out : 0;
+      }
+
+      void add_tx(const std::uint64_t amount, const std::uint64_t fee, const std::uint32_t account, const std::string& txid)
+      {
+        const auto hash = from_hex(txid);
+        const std::lock_guard<std::mutex> lock{sync_};
+        txes_.emplace_back(cfg_, height_, hash.value_or(random_hash()), amount, fee, height_, account, 0, true, true);
+        count(txes_.back());
+        index_last();
+      }
+
+      void run_refresh()
+      {
+        std::unique_lock<std::mutex> lock{sync_};
+        while (!stop_)
+        {
+          notify_.wait_for(lock, std::chrono::milliseconds{refresh_interval_.load()}, [this] () { return stop_; });
+          if (stop_)
+            break;
+          ++height_;
+          Monero::WalletListener* const listener = listener_;
+          lock.unlock();
+          if (listener)
+          {
+            listener->newBlock(height_);
+            listener->refreshed();
+          }
+          lock.lock();
+        }
+      }
+
+    public:
+      wallet_(const config& cfg, std::string path, std::string password, Monero::NetworkType nettype)
+        : cfg_(cfg),
+          path_(std::move(path)),
+          nettype_(nettype),
+          password_(std::move(password)),
+          sync_(),
+          txes_(),
+          by_hash_(),
+          totals_(),
+          labels_(),
+          attributes_(),
+          height_(base_height),
+          rng_(cfg.seed),
+          tx_history_(this),
+          subaddresses_(this),
+          subaccounts_(this),
+          listener_(nullptr),
+          notify_(),
+          refresher_(),
+          refresh_interval_(30000),
+          stop_(false),
+          connected_(false)
+      {
+        generate();
+      }
+
+      ~wallet_() override
+      {
+        {
+          const std::lock_guard<std::mutex> lock{sync_};
+          stop_ = true;
+        }
+        notify_.notify_all();
+        if (refresher_.joinable())
+          refresher_.join();
+      }
+
+      std::string seed(const std::string&) const override { return "mock seed words"; }
+      std::string getSeedLanguage() const override { return "English"; }
+      void setSeedLanguage(const std::string&) override {}
+      int status() const override { return Status_Ok; }
+      std::string errorString() const override { return {}; }
+      void statusWithErrorString(int& status, std::string& errorString) const override
+      {
+        delay();
+        status = Status_Ok;
+        errorString.clear();
+      }
+      bool setPassword(const std::string& password) override { password_ = password; return true; }
+      const std::string& getPassword() const override { return password_; }
+
+      std::string address(std::uint32_t accountIndex, std::uint32_t addressIndex) const override
+      {
+        delay();
+        std::string out;
+        out.reserve(95);
+        out.push_back(accountIndex || addressIndex ? '8' : '4');
+        std::uint64_t state = cfg_.seed ^ (std::uint64_t(accountIndex) << 32) ^ addressIndex;
+        while (out.size() < 95)
+        {
+          state = splitmix(state);
+          out.push_back(base58[state % (sizeof(base58) - 1)]);
+        }
+        return out;
+      }
+
+      std::string path() const override { return path_; }
+      Monero::NetworkType nettype() const override { return nettype_; }
+      void hardForkInfo(std::uint8_t& version, std::uint64_t& earliest_height) const override { version = 16; earliest_height = 0; }
+      bool useForkRules(std::uint8_t, std::int64_t) const override { return true; }
+      std::string integratedAddress(const std::string&) const override { return {}; }
+      std::string secretViewKey() const override { return std::string(64, '1'); }
+      std::string publicViewKey() const override { return std::string(64, '2'); }
+      std::string secretSpendKey() const override { return std::string(64, '3'); }
+      std::string publicSpendKey() const override { return std::string(64, '4'); }
+      std::string publicMultisigSignerKey() const override { return {}; }
+      void stop() override {}
+      bool store(const std::string&) override { delay(); return true; }
+      std::string filename() const override { return path_; }
+      std::string keysFilename() const override { return path_ + ".keys"; }
+
+      bool init(const std::string&, std::uint64_t, const std::string&, const std::string&, bool, bool, const std::string&) override
+      {
+        delay();
+        connected_ = true;
+        return true;
+      }
+
+      bool createWatchOnly(const std::string&, const std::string&, const std::string&) const override { return false; }
+      void setRefreshFromBlockHeight(std::uint64_t) override {}
+      std::uint64_t getRefreshFromBlockHeight() const override { return base_height; }
+      void setRecoveringFromSeed(bool) override {}
+      void setRecoveringFromDevice(bool) override {}
+      void setSubaddressLookahead(std::uint32_t, std::uint32_t) override {}
+      bool connectToDaemon() override { connected_ = true; return true; }
+      ConnectionStatus connected() const override
+      {
+        delay();
+        return connected_ ? ConnectionStatus_Connected : ConnectionStatus_Disconnected;
+      }
+      void setTrustedDaemon(bool) override {}
+      bool trustedDaemon() const override { return true; }
+      bool setProxy(const std::string&) override { return true; }
+
+      std::uint64_t balance(std::uint32_t accountIndex) const override
+      {
+        delay();
+        const std::lock_guard<std::mutex> lock{sync_};
+        return compute_balance(accountIndex);
+      }
+      std::uint64_t unlockedBalance(std::uint32_t accountIndex) const override { return balance(accountIndex); }
+
+      bool watchOnly() const override { return false; }
+      bool isDeterministic() const override { return true; }
+      std::uint64_t blockChainHeight() const override { return height_; }
+      std::uint64_t approximateBlockChainHeight() const override { return height_; }
+      std::uint64_t estimateBlockChainHeight() const override { return height_; }
+      std::uint64_t daemonBlockChainHeight() const override { return height_; }
+      std::uint64_t daemonBlockChainTargetHeight() const override { return height_; }
+      bool synchronized() const override { return true; }
+
+      void startRefresh() override
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (!refresher_.joinable())
+          refresher_ = std::thread{[this] () { run_refresh(); }};
+      }
+      void pauseRefresh() override {}
+      bool refresh() override
+      {
+        delay();
+        Monero::WalletListener* const listener = listener_;
+        if (listener)
+          listener->refreshed();
+        return true;
+      }
+      void refreshAsync() override { notify_.notify_all(); refresh(); }
+      bool rescanBlockchain() override { return refresh(); }
+      void rescanBlockchainAsync() override { refreshAsync(); }
+      void setAutoRefreshInterval(int millis) override { refresh_interval_ = std::max(1, millis); }
+      int autoRefreshInterval() const override { return refresh_interval_; }
+
+      void addSubaddressAccount(const std::string& label) override
+      {
+        delay();
+        const std::lock_guard<std::mutex> lock{sync_};
+        labels_.emplace_back(1, label);
+      }
+      std::size_t numSubaddressAccounts() const override
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        return labels_.size();
+      }
+      std::size_t numSubaddresses(std::uint32_t accountIndex) const override
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        return accountIndex < labels_.size() ? labels_[accountIndex].size() : 0;
+      }
+      void addSubaddress(std::uint32_t accountIndex, const std::string& label) override
+      {
+        delay();
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (accountIndex < labels_.size())
+          labels_[accountIndex].push_back(label);
+      }
+      std::string getSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex) const override
+      {
+        delay();
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (accountIndex < labels_.size() && addressIndex < labels_[accountIndex].size())
+          return labels_[accountIndex][addressIndex];
+        return {};
+      }
+      void setSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label) override
+      {
+        delay();
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (accountIndex < labels_.size() && addressIndex < labels_[accountIndex].size())
+          labels_[accountIndex][addressIndex] = label;
+      }
+
+      Monero::MultisigState multisig() const override { return {}; }
+      std::string getMultisigInfo() const override { return {}; }
+      std::string makeMultisig(const std::vector<std::string>&, std::uint32_t) override { return {}; }
+      std::string exchangeMultisigKeys(const std::vector<std::string>&, const bool) override { return {}; }
+      bool exportMultisigImages(std::string&) override { return false; }
+      std::size_t importMultisigImages(const std::vector<std::string>&) override { return 0; }
+      bool hasMultisigPartialKeyImages() const override { return false; }
+      Monero::PendingTransaction* restoreMultisigTransaction(const std::string&) override { return nullptr; }
+
+      Monero::PendingTransaction* createTransactionMultDest(const std::vector<std::string>& dst_addr, const std::string&, Monero::optional<std::vector<std::uint64_t>> amount, std::uint32_t, Monero::PendingTransaction::Priority, std::uint32_t subaddr_account, std::set<std::uint32_t>) override
+      {
+        delay();
+        std::uint64_t total = 0;
+        if (amount)
+        {
+          for (const std::uint64_t value : *amount)
+            total += value;
+        }
+        else
+          total = balance(subaddr_account);
+
+        const std::lock_guard<std::mutex> lock{sync_};
+        const std::uint64_t fee = 30000000 * std::max<std::size_t>(1, dst_addr.size());
+        return new pending_{this, random_hex(rng_), total, fee, subaddr_account};
+      }
+      Monero::PendingTransaction* createTransaction(const std::string& dst_addr, const std::string& payment_id, Monero::optional<std::uint64_t> amount, std::uint32_t mixin_count, Monero::PendingTransaction::Priority priority, std::uint32_t subaddr_account, std::set<std::uint32_t> subaddr_indices) override
+      {
+        Monero::optional<std::vector<std::uint64_t>> amounts;
+        if (amount)
+          amounts = std::vector<std::uint64_t>{*amount};
+        return createTransactionMultDest({dst_addr}, payment_id, amounts, mixin_count, priority, subaddr_account, std::move(subaddr_indices));
+      }
+      Monero::PendingTransaction* createSweepUnmixableTransaction() override { return nullptr; }
+      Monero::UnsignedTransaction* loadUnsignedTx(const std::string&) override { return nullptr; }
+      bool submitTransaction(const std::string&) override { return false; }
+      void disposeTransaction(Monero::PendingTransaction* t) override { delete t; }
+      std::uint64_t estimateTransactionFee(const std::vector<std::pair<std::string, std::uint64_t>>& destinations, Monero::PendingTransaction::Priority) const override
+      {
+        return 30000000 * std::max<std::size_t>(1, destinations.size());
+      }
+
+      bool exportKeyImages(const std::string&, bool) override { return false; }
+      bool importKeyImages(const std::string&) override { return false; }
+      bool exportOutputs(const std::string&, bool) override { return false; }
+      bool importOutputs(const std::string&) override { return false; }
+      bool scanTransactions(const std::vector<std::string>&) override { return false; }
+
+      bool setupBackgroundSync(const BackgroundSyncType, const std::string&, const Monero::optional<std::string>&) override { return false; }
+      BackgroundSyncType getBackgroundSyncType() const override { return BackgroundSync_Off; }
+      bool startBackgroundSync() override { return false; }
+      bool stopBackgroundSync(const std::string&) override { return false; }
+      bool isBackgroundSyncing() const override { return false; }
+      bool isBackgroundWallet() const override { return false; }
+
+      Monero::TransactionHistory* history() override { delay(); return std::addressof(tx_history_); }
+      Monero::AddressBook* addressBook() override { return nullptr; }
+      Monero::Coins* coins() override { return nullptr; }
+      Monero::Subaddress* subaddress() override { return std::addressof(subaddresses_); }
+      Monero::SubaddressAccount* subaddressAccount() override { return std::addressof(subaccounts_); }
+      void setListener(Monero::WalletListener* listener) override { listener_ = listener; }
+      std::uint32_t defaultMixin() const override { return 15; }
+      void setDefaultMixin(std::uint32_t) override {}
+
+      bool setCacheAttribute(const std::string& key, const std::string& val) override
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        attributes_[key] = val;
+        return true;
+      }
+      std::string getCacheAttribute(const std::string& key) const override
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        const auto match = attributes_.find(key);
+        return match == attributes_.end() ? std::string{} : match->second;
+      }
+
+      bool setUserNote(const std::string&, const std::string&) override { return false; }
+      std::string getUserNote(const std::string&) const override { return {}; }
+      std::string getTxKey(const std::string&) const override { return {}; }
+      bool checkTxKey(const std::string&, std::string, const std::string&, std::uint64_t&, bool&, std::uint64_t&) override { return false; }
+      std::string getTxProof(const std::string&, const std::string&, const std::string&) const override { return {}; }
+      bool checkTxProof(const std::string&, const std::string&, const std::string&, const std::string&, bool&, std::uint64_t&, bool&, std::uint64_t&) override { return false; }
+      std::string getSpendProof(const std::string&, const std::string&) const override { return {}; }
+      bool checkSpendProof(const std::string&, const std::string&, const std::string&, bool&) const override { return false; }
+      std::string getReserveProof(bool, std::uint32_t, std::uint64_t, const std::string&) const override { return {}; }
+      bool checkReserveProof(const std::string&, const std::string&, const std::string&, bool&, std::uint64_t&, std::uint64_t&) const override { return false; }
+      std::string signMessage(const std::string&, const std::string&) override { return {}; }
+      bool verifySignedMessage(const std::string&, const std::string&, const std::string&) const override { return false; }
+      std::string signMultisigParticipant(const std::string&) const override { return {}; }
+      bool verifyMessageWithPublicKey(const std::string&, const std::string&, const std::string&) const override { return false; }
+      bool parse_uri(const std::string&, std::string&, std::string&, std::uint64_t&, std::string&, std::string&, std::vector<std::string>&, std::string& error) override
+      {
+        error = "not supported by mock";
+        return false;
+      }
+      std::string make_uri(const std::string&, const std::string&, std::uint64_t, const std::string&, const std::string&, std::string& error) const override
+      {
+        error = "not supported by mock";
+        return {};
+      }
+      std::string getDefaultDataDir() const override { return {}; }
+      bool rescanSpent() override { return true; }
+      void setOffline(bool offline) override { connected_ = !offline; }
+      bool isOffline() const override { return !connected_; }
+      bool blackballOutputs(const std::vector<std::string>&, bool) override { return false; }
+      bool blackballOutput(const std::string&, const std::string&) override { return false; }
+      bool unblackballOutput(const std::string&, const std::string&) override { return false; }
+      bool getRing(const std::string&, std::vector<std::uint64_t>&) const override { return false; }
+      bool getRings(const std::string&, std::vector<std::pair<std::string, std::vector<std::uint64_t>>>&) const override { return false; }
+      bool setRing(const std::string&, const std::vector<std::uint64_t>&, bool) override { return false; }
+      void segregatePreForkOutputs(bool) override {}
+      void segregationHeight(std::uint64_t) override {}
+      void keyReuseMitigation2(bool) override {}
+      bool lightWalletLogin(bool& isNewWallet) const override { isNewWallet = false; return true; }
+      bool lightWalletImportWalletRequest(std::string&, std::uint64_t&, bool&, bool&, std::string&, std::string&) override { return false; }
+      bool lockKeysFile() override { return true; }
+      bool unlockKeysFile() override { return true; }
+      bool isKeysFileLocked() override { return false; }
+      Device getDeviceType() const override { return Device_Software; }
+      std::uint64_t coldKeyImageSync(std::uint64_t&, std::uint64_t&) override { return 0; }
+      void deviceShowAddress(std::uint32_t, std::uint32_t, const std::string&) override {}
+      bool reconnectDevice() override { return false; }
+      std::uint64_t getBytesReceived() override { return 0; }
+      std::uint64_t getBytesSent() override { return 0; }
+    };
+
+    Monero::TransactionInfo* history_::transaction(const int index) const
+    {
+      if (index < 0 || all_.size() <= std::size_t(index))
+        return nullptr;
+      return all_[index];
+    }
+
+    Monero::TransactionInfo* history_::transaction(const std::string& id) const
+    {
+      wal_->delay();
+      const std::lock_guard<std::mutex> lock{wal_->sync_};
+      return const_cast<tx_info*>(wal_->find_tx(id));
+    }
+
+    void history_::refresh()
+    {
+      wal_->delay();
+      const std::lock_guard<std::mutex> lock{wal_->sync_};
+      all_.clear();
+      all_.reserve(wal_->txes_.size());
+      for (tx_info& tx : wal_->txes_)
+        all_.push_back(std::addressof(tx));
+    }
+
+    void history_::setTxNote(const std::string& txid, const std::string& note)
+    {
+      wal_->delay();
+      const std::lock_guard<std::mutex> lock{wal_->sync_};
+      tx_info* const tx = const_cast<tx_info*>(wal_->find_tx(txid));
+      if (tx)
+        tx->set_note(note);
+    }
+
+    void subaddress_::addRow(const std::uint32_t accountIndex, const std::string& label)
+    {
+      wal_->addSubaddress(accountIndex, label);
+    }
+
+    void subaddress_::setLabel(const std::uint32_t accountIndex, const std::uint32_t addressIndex, const std::string& label)
+    {
+      wal_->setSubaddressLabel(accountIndex, addressIndex, label);
+    }
+
+    void subaddress_::refresh(const std::uint32_t accountIndex)
+    {
+      const std::size_t count = wal_->numSubaddresses(accountIndex);
+      rows_.clear();
+      rows_.reserve(count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        rows_.push_back(std::make_unique<Monero::SubaddressRow>(
+          i, wal_->address(accountIndex, std::uint32_t(i)), wal_->getSubaddressLabel(accountIndex, std::uint32_t(i))
+        ));
+      }
+    }
+
+    void accounts_::addRow(const std::string& label)
+    {
+      wal_->addSubaddressAccount(label);
+    }
+
+    void accounts_::setLabel(const std::uint32_t accountIndex, const std::string& label)
+    {
+      wal_->setSubaddressLabel(accountIndex, 0, label);
+    }
+
+    void accounts_::refresh()
+    {
+      const std::size_t count = wal_->numSubaddressAccounts();
+      rows_.clear();
+      rows_.reserve(count);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const std::uint32_t major = std::uint32_t(i);
+        const std::string balance = lwsf::displayAmount(wal_->balance(major));
+        rows_.push_back(std::make_unique<Monero::SubaddressAccountRow>(
+          i, wal_->address(major, 0), wal_->getSubaddressLabel(major, 0), balance, balance
+        ));
+      }
+    }
+
+    bool pending_::commit(const std::string&, bool)
+    {
+      wal_->delay();
+      wal_->add_tx(amount_, fee_, account_, txid_.front());
+      return true;
+    }
+
+    class manager_ final : public Monero::WalletManager
+    {
+      const config cfg_;
+      std::string error_;
+
+      Monero::Wallet* make(const std::string& path, const std::string& password, const Monero::NetworkType nettype) const
+      {
+        if (cfg_.latency.count())
+          std::this_thread::sleep_for(cfg_.latency);
+        return new wallet_{cfg_, path, password, nettype};
+      }
+
+    public:
+      explicit manager_(const config& cfg)
+        : cfg_(cfg), error_()
+      {}
+
+      Monero::Wallet* createWallet(const std::string& path, const std::string& password, const std::string&, Monero::NetworkType nettype, std::uint64_t) override
+      { return make(path, password, nettype); }
+
+      Monero::Wallet* openWallet(const std::string& path, const std::string& password, Monero::NetworkType nettype, std::uint64_t, Monero::WalletListener* listener) override
+      {
+        Monero::Wallet* const out = make(path, password, nettype);
+        out->setListener(listener);
+        return out;
+      }
+
+      Monero::Wallet* recoveryWallet(const std::string& path, const std::string& password, const std::string&, Monero::NetworkType nettype, std::uint64_t, std::uint64_t, const std::string&) override
+      { return make(path, password, nettype); }
+
+      Monero::Wallet* createWalletFromKeys(const std::string& path, const std::string& password, const std::string&, Monero::NetworkType nettype, std::uint64_t, const std::string&, const std::string&, const std::string&, std::uint64_t) override
+      { return make(path, password, nettype); }
+
+      Monero::Wallet* createDeterministicWalletFromSpendKey(const std::string& path, const std::string& password, const std::string&, Monero::NetworkType nettype, std::uint64_t, const std::string&, std::uint64_t) override
+      { return make(path, password, nettype); }
+
+      Monero::Wallet* createWalletFromDevice(const std::string& path, const std::string& password, Monero::NetworkType nettype, const std::string&, std::uint64_t, const std::string&, std::uint64_t, Monero::WalletListener*) override
+      { return make(path, password, nettype); }
+
+      bool closeWallet(Monero::Wallet* wallet, bool) override
+      {
+        delete wallet;
+        return true;
+      }
+
+      bool walletExists(const std::string&) override { return true; }
+      bool verifyWalletPassword(const std::string&, const std::string&, bool, std::uint64_t) const override { return true; }
+      bool queryWalletDevice(Monero::Wallet::Device& device_type, const std::string&, const std::string&, std::uint64_t) const override
+      {
+        device_type = Monero::Wallet::Device_Software;
+        return true;
+      }
+      std::vector<std::string> findWallets(const std::string&) override { return {}; }
+      std::string errorString() const override { return error_; }
+      void setDaemonAddress(const std::string&) override {}
+      bool connected(std::uint32_t*) override { return true; }
+      std::uint64_t blockchainHeight() override { return base_height + cfg_.txs * blocks_per_tx; }
+      std::uint64_t blockchainTargetHeight() override { return blockchainHeight(); }
+      std::uint64_t networkDifficulty() override { return 0; }
+      double miningHashRate() override { return 0; }
+      std::uint64_t blockTarget() override { return 120; }
+      bool isMining() override { return false; }
+      bool startMining(const std::string&, std::uint32_t, bool, bool) override { return false; }
+      bool stopMining() override { return false; }
+      std::string resolveOpenAlias(const std::string&, bool& dnssec_valid) const override
+      {
+        dnssec_valid = false;
+        return {};
+      }
+      bool setProxy(const std::string&) override { return true; }
+    };
+  } // anonymous
+
+  std::optional<config> parse(const std::string_view spec)
+  {
+    config out{};
+    std::size_t start = 0;
+    while (start < spec.size())
+    {
+      const std::size_t end = std::min(spec.find(',', start), spec.size());
+      const std::string_view entry = spec.substr(start, end - start);
+      start = end + 1;
+
+      const std::size_t split = entry.find('=');
+      if (split == std::string_view::npos)
+        return std::nullopt;
+
+      const std::string_view key = entry.substr(0, split);
+      const auto value = from_string(entry.substr(split + 1));
+      if (!value)
+        return std::nullopt;
+
+      if (key == "seed")
+        out.seed = *value;
+      else if (key == "txs")
+        out.txs = *value;
+      else if (key == "accounts" && *value <= std::numeric_limits<std::uint32_t>::max())
+        out.accounts = std::uint32_t(*value);
+      else if (key == "subaddresses" && *value <= std::numeric_limits<std::uint32_t>::max())
+        out.subaddresses = std::uint32_t(*value);
+      else if (key == "latency_us")
+        out.latency = std::chrono::microseconds{*value};
+      else
+        return std::nullopt;
+    }
+    return out;
+  }
+
+  Monero::WalletManager* wallet_manager(const config& cfg)
+  {
+    return new manager_{cfg};
+  }
+}} // lwcli // mock
@@ -0,0 +1,312 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "failover.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <lws_frontend.h>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "lwcli_config.h"
+#include "net/probe.h"
+#include "timer.h"
+#include "trace.h"
+
+namespace lwcli { namespace net
+{
+  namespace
+  {
+    //! \return Round trip in milliseconds, or nothing if the server failed.
+    std::optional<double> measure(const std::string& url, const std::string& proxy, const bool ssl)
+    {
+      const probe_result result = probe(url, proxy, ssl, 1, config::failover_probe_timeout);
+      if (result.samples.empty())
+        return std::nullopt;
+      const sample& one = result.samples.front();
+      return std::chrono::duration<double, std::milli>{one.connect + one.tls + one.request}.count();
+    }
+  }
+
+  std::vector<std::string> endpoints(const std::string& primary, std::string_view fallbacks)
+  {
+    std::vector<std::string> out;
+    if (!primary.empty())
+      out.push_back(primary);
+
+    const auto separator = [] (const char c) { return c == ',' || std::isspace(static_cast<unsigned char>(c)); };
+    while (!fallbacks.empty())
+    {
+      const auto end = std::find_if(fallbacks.begin(), fallbacks.end(), separator);
+      const std::string url{fallbacks.begin(), end};
+      if (!url.empty() && std::find(out.begin(), out.end(), url) == out.end())
+        out.push_back(url);
+      fallbacks.remove_prefix(std::min(fallbacks.size(), url.size() + 1));
+    }
+    return out;
+  }
+
+  struct failover::state
+  {
+    const std::weak_ptr<Monero::Wallet> wal;
+    std::mutex init; //!< Serializes `Wallet::init`, taken before `sync`
+    mutable std::mutex sync;
+    std::condition_variable wake;
+    std::thread thread;
+    std::vector<std::string> urls;
+    std::string proxy;
+    std::string active;
+    std::string proposed;                  //!< Chosen by `monitor`, cleared by `switch_to`
+    std::map<std::string, double> latency; //!< Moving average (ms) of healthy endpoints
+    std::uint64_t generation;              //!< Incremented when `urls` is replaced
+    bool ssl;
+    bool running;
+    bool stop;
+
+    explicit state(const std::shared_ptr<Monero::Wallet>& wal)
+      : wal(wal),
+        init(),
+        sync(),
+        wake(),
+        thread(),
+        urls(),
+        proxy(),
+        active(),
+        proposed(),
+        latency(),
+        generation(0),
+        ssl(false),
+        running(false),
+        stop(false)
+    {}
+
+    //! Call with `sync` held.
+    void start()
+    {
+      if (running || stop || urls.size() < 2)
+        return;
+      if (thread.joinable())
+        thread.join(); // previous monitor is past its last use of `sync`
+      running = true;
+      thread = std::thread{&state::monitor, this};
+    }
+
+    bool stopping() const
+    {
+      const std::lock_guard<std::mutex> lock{sync};
+      return stop;
+    }
+
+    //! \return Endpoint to move to, or empty to stay. Call with `sync` held.
+    std::string choose() const
+    {
+      const auto best = std::min_element(
+        latency.begin(), latency.end(),
+        [] (const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; }
+      );
+      if (best == latency.end() || best->first == active)
+        return {};
+
+      const auto current = latency.find(active);
+      if (current == latency.end())
+        return best->first; // active server failed its probe
+
+      if (best->second * (100 + config::failover_margin) < current->second * 100)
+        return best->first;
+      return {};
+    }
+
+    static void monitor(state* const self)
+    {
+      std::unique_lock<std::mutex> lock{self->sync};
+      while (!self->stop && 2 <= self->urls.size())
+      {
+        const std::vector<std::string> current = self->urls;
+        const std::string route = self->proxy;
+        const bool verify = self->ssl;
+        const std::uint64_t expected = self->generation;
+        lock.unlock();
+
+        std::vector<std::optional<double>> measured;
+        measured.reserve(current.size());
+        for (const std::string& url : current)
+        {
+          if (self->stopping())
+            break;
+          measured.push_back(measure(url, route, verify));
+        }
+
+        lock.lock();
+        if (self->stop)
+          break;
+
+        if (expected == self->generation)
+        {
+          for (std::size_t i = 0; i < current.size(); ++i)
+          {
+            if (!measured[i])
+            {
+              self->latency.erase(current[i]);
+              continue;
+            }
+
+            const auto inserted = self->latency.try_emplace(current[i], *measured[i]);
+            if (!inserted.second)
+              inserted.first->second = inserted.first->second * 0.7 + *measured[i] * 0.3;
+          }
+
+          // the UI runs `switch_to` when nothing else is using the wallet
+          const std::string next = self->choose();
+          if (!next.empty() && next != self->proposed)
+          {
+            self->proposed = next;
+            lock.unlock();
+            timer::redraw();
+            lock.lock();
+          }
+        }
+
+        self->wake.wait_for(lock, config::failover_interval, [&] () {
+          return self->stop || expected != self->generation;
+        });
+      }
+      self->running = false;
+    }
+  };
+
+  failover::failover(const std::shared_ptr<Monero::Wallet>& wal, const config::wallet_store& settings)
+    : state_(nullptr)
+  {
+    if (!wal)
+      throw std::invalid_argument{"net::failover given nullptr"};
+
+    state_ = std::make_shared<state>(wal);
+    state_->urls = endpoints(settings.get<config::keys::url>(), settings.get<config::keys::fallbacks>());
+    state_->proxy = settings.get<config::keys::proxy>();
+    state_->ssl = settings.get<config::keys::ssl>();
+    if (!state_->urls.empty())
+      state_->active = state_->urls.front(); // `init_wallet` connected here, or `connect` will
+
+    const std::lock_guard<std::mutex> lock{state_->sync};
+    state_->start();
+  }
+
+  failover::~failover() noexcept
+  {
+    {
+      const std::lock_guard<std::mutex> lock{state_->sync};
+      state_->stop = true;
+    }
+    state_->wake.notify_all();
+    if (state_->thread.joinable())
+      state_->thread.join();
+  }
+
+  bool failover::connect(std::vector<std::string> urls, std::string proxy, const bool ssl)
+  {
+    const std::lock_guard<std::mutex> serialize{state_->init};
+    const std::shared_ptr<Monero::Wallet> wal = state_->wal.lock();
+    if (!wal)
+      return false;
+
+    {
+      const std::lock_guard<std::mutex> lock{state_->sync};
+      state_->urls = std::move(urls);
+      state_->proxy = std::move(proxy);
+      state_->ssl = ssl;
+      state_->proposed.clear();
+      state_->latency.clear();
+      ++state_->generation;
+    }
+    state_->wake.notify_all();
+
+    for (const std::string& url : state_->urls)
+    {
+      if (LWCLI_TRACE_CALL("Wallet::init", wal->init(url, 0, "", "", ssl, true, state_->proxy)))
+      {
+        // a first connect that failed never started refresh
+        LWCLI_TRACE_CALL("Wallet::startRefresh", wal->startRefresh());
+        const std::lock_guard<std::mutex> lock{state_->sync};
+        state_->active = url;
+        state_->start();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string failover::proposed() const
+  {
+    const std::lock_guard<std::mutex> lock{state_->sync};
+    return state_->proposed;
+  }
+
+  bool failover::switch_to(const std::string& url)
+  {
+    const std::lock_guard<std::mutex> serialize{state_->init};
+    const std::shared_ptr<Monero::Wallet> wal = state_->wal.lock();
+    if (!wal)
+      return false;
+
+    std::string proxy;
+    bool ssl = false;
+    {
+      const std::lock_guard<std::mutex> lock{state_->sync};
+      if (state_->proposed != url)
+        return false; // `connect` replaced the list
+      proxy = state_->proxy;
+      ssl = state_->ssl;
+    }
+
+    const bool connected =
+      LWCLI_TRACE_CALL("Wallet::init", wal->init(url, 0, "", "", ssl, true, proxy));
+    if (connected)
+      LWCLI_TRACE_CALL("Wallet::startRefresh", wal->startRefresh());
+
+    const std::lock_guard<std::mutex> lock{state_->sync};
+    if (state_->proposed == url)
+      state_->proposed.clear();
+    if (connected)
+      state_->active = url;
+    else
+      state_->latency.erase(url);
+    return connected;
+  }
+
+  std::string failover::active() const
+  {
+    const std::lock_guard<std::mutex> lock{state_->sync};
+    return state_->active;
+  }
+}} // lwcli // net
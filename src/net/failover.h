@@ -0,0 +1,83 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wallet_config.h"
+
+namespace lwcli { namespace net
+{
+  //! \return `primary` followed by the comma or space separated `fallbacks`, without duplicates.
+  std::vector<std::string> endpoints(const std::string& primary, std::string_view fallbacks);
+
+  /*! Keeps a wallet connected to the fastest healthy light-wallet server.
+    A background thread probes every endpoint each `config::failover_interval`
+    and keeps a moving average of the latency. Another server is proposed
+    when the active one fails a probe, or when another is faster by more
+    than `config::failover_margin` percent, so near ties do not bounce
+    between servers. The thread never calls the wallet; it posts a redraw
+    and the UI calls `switch_to` once nothing else is using the wallet. The
+    thread only runs while there is more than one endpoint. Destruction
+    waits for an in-flight probe, which is bounded by
+    `config::failover_probe_timeout`. */
+  class failover
+  {
+    struct state;
+    std::shared_ptr<state> state_;
+
+  public:
+    /*! Endpoints, proxy and SSL are copied from `settings`. Does not
+      connect; the first endpoint is assumed active until `connect`. */
+    failover(const std::shared_ptr<Monero::Wallet>& wal, const config::wallet_store& settings);
+    ~failover() noexcept;
+
+    failover(const failover&) = delete;
+    failover& operator=(const failover&) = delete;
+
+    /*! Replaces the endpoint list and connects to the first one that
+      `Wallet::init` accepts, then starts refresh. Blocks; call off the UI
+      thread. \return False if none were accepted. */
+    bool connect(std::vector<std::string> urls, std::string proxy, bool ssl);
+
+    //! \return Server the monitor wants to move to, or empty. Thread-safe.
+    std::string proposed() const;
+
+    /*! Calls `Wallet::init` for `url` and starts refresh, if `url` is still
+      `proposed()`. Blocks; call off the UI thread while nothing else uses
+      the wallet. \return True if the wallet moved to `url`. */
+    bool switch_to(const std::string& url);
+
+    //! \return URL of the server in use. Thread-safe.
+    std::string active() const;
+  };
+}} // lwcli // net
@@ -0,0 +1,524 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "probe.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <netdb.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "lwcli_config.h"
+
+namespace lwcli { namespace net
+{
+  namespace
+  {
+    using clock = std::chrono::steady_clock;
+
+    //! Thrown for a failed sample; `probe` records it and moves on
+    struct failure : std::runtime_error
+    {
+      using std::runtime_error::runtime_error;
+    };
+
+    /*! Blocks `SIGPIPE` on this thread. OpenSSL writes to the socket without
+      `MSG_NOSIGNAL`, and a peer reset would otherwise kill the process. */
+    class block_sigpipe
+    {
+      sigset_t pipe_;
+      sigset_t previous_;
+      bool was_pending_;
+
+    public:
+      block_sigpipe() noexcept
+        : pipe_(), previous_(), was_pending_(false)
+      {
+        sigemptyset(&pipe_);
+        sigaddset(&pipe_, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe_, &previous_);
+
+        sigset_t pending{};
+        sigpending(&pending);
+        was_pending_ = sigismember(&pending, SIGPIPE) == 1;
+      }
+
+      ~block_sigpipe() noexcept
+      {
+        // discard a `SIGPIPE` raised here, before it can be delivered
+        sigset_t pending{};
+        sigpending(&pending);
+        if (!was_pending_ && sigismember(&pending, SIGPIPE) == 1)
+        {
+          const timespec now{0, 0};
+          sigtimedwait(&pipe_, nullptr, &now);
+        }
+        pthread_sigmask(SIG_SETMASK, &previous_, nullptr);
+      }
+
+      block_sigpipe(const block_sigpipe&) = delete;
+      block_sigpipe& operator=(const block_sigpipe&) = delete;
+    };
+
+    struct endpoint
+    {
+      std::string host;
+      std::string port;
+      std::string path;
+      bool tls;
+    };
+
+    //! Splits `[scheme://]host[:port][/path]`. IPv6 hosts use brackets.
+    endpoint parse_url(std::string_view url, const bool need_port = false)
+    {
+      endpoint out{{}, {}, "/", false};
+
+      const std::size_t scheme = url.find("://");
+      if (scheme != std::string_view::npos)
+      {
+        const std::string_view name = url.substr(0, scheme);
+        if (name == "https")
+          out.tls = true;
+        else if (name != "http" && name != "socks5")
+          throw failure{"Unsupported scheme " + std::string{name}};
+        url.remove_prefix(scheme + 3);
+      }
+
+      const std::size_t path = url.find('/');
+      if (path != std::string_view::npos)
+      {
+        out.path = std::string{url.substr(path)};
+        url = url.substr(0, path);
+      }
+
+      std::size_t port = url.rfind(':');
+      if (!url.empty() && url.front() == '[')
+      {
+        const std::size_t end = url.find(']');
+        if (end == std::string_view::npos)
+          throw failure{"Invalid IPv6 address"};
+        out.host = std::string{url.substr(1, end - 1)};
+        port = (end + 1 < url.size() && url[end + 1] == ':') ? end + 1 : std::string_view::npos;
+      }
+      else
+        out.host = std::string{url.substr(0, port)};
+
+      if (port != std::string_view::npos)
+        out.port = std::string{url.substr(port + 1)};
+      else if (need_port)
+        throw failure{"Missing port for " + out.host};
+      else
+        out.port = out.tls ? "443" : "80";
+
+      if (out.host.empty())
+        throw failure{"Missing host"};
+      return out;
+    }
+
+    int remaining_ms(const clock::time_point deadline)
+    {
+      const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+      return int(std::max(left.count(), std::chrono::milliseconds::rep(0)));
+    }
+
+    std::string system_error(const char* what, const int error)
+    {
+      if (error == EAGAIN || error == EWOULDBLOCK)
+        return std::string{what} + ": timeout";
+      return std::string{what} + ": " + std::strerror(error);
+    }
+
+    class socket_
+    {
+      int fd_;
+
+    public:
+      explicit socket_(const int fd) noexcept
+        : fd_(fd)
+      {}
+
+      socket_(socket_&& rhs) noexcept
+        : fd_(rhs.fd_)
+      { rhs.fd_ = -1; }
+
+      ~socket_() noexcept
+      {
+        if (0 <= fd_)
+          ::close(fd_);
+      }
+
+      socket_(const socket_&) = delete;
+      socket_& operator=(const socket_&) = delete;
+      socket_& operator=(socket_&&) = delete;
+
+      int get() const noexcept { return fd_; }
+
+      //! Switches to blocking reads and writes that give up at `deadline`
+      void set_deadline(const clock::time_point deadline) const
+      {
+        const int flags = ::fcntl(fd_, F_GETFL);
+        if (flags < 0 || ::fcntl(fd_, F_SETFL, flags & ~O_NONBLOCK) < 0)
+          throw failure{system_error("fcntl", errno)};
+
+        const int ms = std::max(remaining_ms(deadline), 1);
+        const timeval timeout{ms / 1000, (ms % 1000) * 1000};
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+      }
+
+      void send_all(std::string_view bytes) const
+      {
+        while (!bytes.empty())
+        {
+          const ssize_t sent = ::send(fd_, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+          if (sent < 0 && errno == EINTR)
+            continue;
+          if (sent <= 0)
+            throw failure{system_error("Send", errno)};
+          bytes.remove_prefix(sent);
+        }
+      }
+
+      void recv_all(void* const dest, std::size_t length) const
+      {
+        char* out = static_cast<char*>(dest);
+        while (length)
+        {
+          const ssize_t read = ::recv(fd_, out, length, 0);
+          if (read < 0 && errno == EINTR)
+            continue;
+          if (read == 0)
+            throw failure{"Connection closed"};
+          if (read < 0)
+            throw failure{system_error("Receive", errno)};
+          out += read;
+          length -= read;
+        }
+      }
+    };
+
+    socket_ tcp_connect(const endpoint& to, const clock::time_point deadline)
+    {
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+
+      addrinfo* found = nullptr;
+      const int error = ::getaddrinfo(to.host.c_str(), to.port.c_str(), &hints, &found);
+      if (error)
+        throw failure{"Resolving " + to.host + ": " + ::gai_strerror(error)};
+      const std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> addresses{found, &::freeaddrinfo};
+
+      std::string last = "no addresses";
+      for (const addrinfo* addr = addresses.get(); addr; addr = addr->ai_next)
+      {
+        socket_ sock{::socket(addr->ai_family, addr->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, addr->ai_protocol)};
+        if (sock.get() < 0)
+        {
+          last = std::strerror(errno);
+          continue;
+        }
+
+        if (::connect(sock.get(), addr->ai_addr, addr->ai_addrlen) != 0)
+        {
+          if (errno != EINPROGRESS)
+          {
+            last = std::strerror(errno);
+            continue;
+          }
+
+          pollfd wait{sock.get(), POLLOUT, 0};
+          const int ready = ::poll(std::addressof(wait), 1, remaining_ms(deadline));
+          if (ready == 0)
+            throw failure{"Connecting to " + to.host + ": timeout"};
+
+          int result = 0;
+          socklen_t length = sizeof(result);
+          if (ready < 0)
+            result = errno;
+          else if (::getsockopt(sock.get(), SOL_SOCKET, SO_ERROR, &result, &length) != 0)
+            result = errno;
+          if (result)
+          {
+            last = std::strerror(result);
+            continue;
+          }
+        }
+
+        sock.set_deadline(deadline);
+        return sock;
+      }
+      throw failure{"Connecting to " + to.host + ": " + last};
+    }
+
+    //! RFC 1928 CONNECT with no authentication. The proxy resolves `to.host`.
+    void socks5_connect(const socket_& sock, const endpoint& to)
+    {
+      if (255 < to.host.size())
+        throw failure{"Hostname too long for SOCKS5"};
+
+      unsigned long port = 0;
+      try { port = std::stoul(to.port); }
+      catch (const std::exception&) { port = 65536; }
+      if (65535 < port)
+        throw failure{"Invalid port " + to.port};
+
+      sock.send_all({"\x05\x01\x00", 3});
+
+      std::array<std::uint8_t, 4> reply{};
+      sock.recv_all(reply.data(), 2);
+      if (reply[0] != 5 || reply[1] != 0)
+        throw failure{"SOCKS5 proxy requires authentication"};
+
+      std::string request{"\x05\x01\x00\x03", 4};
+      request.push_back(char(to.host.size()));
+      request.append(to.host);
+      request.push_back(char(port >> 8));
+      request.push_back(char(port & 0xff));
+      sock.send_all(request);
+
+      sock.recv_all(reply.data(), reply.size());
+      if (reply[0] != 5 || reply[1] != 0)
+        throw failure{"SOCKS5 proxy refused connection (code " + std::to_string(reply[1]) + ")"};
+
+      std::size_t skip = 2; // bound port
+      if (reply[3] == 1)
+        skip += 4;
+      else if (reply[3] == 4)
+        skip += 16;
+      else if (reply[3] == 3)
+      {
+        std::uint8_t length = 0;
+        sock.recv_all(&length, 1);
+        skip += length;
+      }
+      else
+        throw failure{"SOCKS5 proxy sent invalid address"};
+
+      std::array<char, 256 + 2> ignored{};
+      sock.recv_all(ignored.data(), skip);
+    }
+
+    std::string tls_error(const char* what)
+    {
+      std::array<char, 256> buffer{};
+      const unsigned long code = ::ERR_get_error();
+      ::ERR_clear_error();
+      if (!code)
+        return std::string{what} + ": connection closed";
+      ::ERR_error_string_n(code, buffer.data(), buffer.size());
+      return std::string{what} + ": " + buffer.data();
+    }
+
+    struct free_ssl
+    {
+      void operator()(SSL* ptr) const noexcept { ::SSL_free(ptr); }
+      void operator()(SSL_CTX* ptr) const noexcept { ::SSL_CTX_free(ptr); }
+    };
+    using ssl_context = std::unique_ptr<SSL_CTX, free_ssl>;
+    using ssl_stream = std::unique_ptr<SSL, free_ssl>;
+
+    ssl_context make_context(const bool verify)
+    {
+      ssl_context ctx{::SSL_CTX_new(::TLS_client_method())};
+      if (!ctx)
+        throw std::runtime_error{tls_error("SSL_CTX_new")};
+      if (verify)
+      {
+        if (!::SSL_CTX_set_default_verify_paths(ctx.get()))
+          throw std::runtime_error{tls_error("Loading CA certificates")};
+        ::SSL_CTX_set_verify(ctx.get(), SSL_VERIFY_PEER, nullptr);
+      }
+      return ctx;
+    }
+
+    ssl_stream tls_handshake(SSL_CTX& ctx, const socket_& sock, const endpoint& to, const bool verify)
+    {
+      ssl_stream ssl{::SSL_new(std::addressof(ctx))};
+      if (!ssl)
+        throw failure{tls_error("SSL_new")};
+
+      ::SSL_set_fd(ssl.get(), sock.get());
+      ::SSL_set_tlsext_host_name(ssl.get(), to.host.c_str());
+      if (verify)
+        ::SSL_set1_host(ssl.get(), to.host.c_str());
+
+      if (::SSL_connect(ssl.get()) != 1)
+      {
+        const long result = ::SSL_get_verify_result(ssl.get());
+        if (result != X509_V_OK)
+          throw failure{std::string{"Certificate: "} + ::X509_verify_cert_error_string(result)};
+        throw failure{tls_error("TLS handshake")};
+      }
+      return ssl;
+    }
+
+    //! Sends a GET and waits for the status line; any HTTP status counts
+    void round_trip(const socket_& sock, SSL* const ssl, const endpoint& to)
+    {
+      const std::string request =
+        "GET " + to.path + " HTTP/1.1\r\nHost: " + to.host + "\r\nConnection: close\r\n\r\n";
+
+      std::array<char, 5> status{};
+      if (ssl)
+      {
+        if (::SSL_write(ssl, request.data(), request.size()) <= 0)
+          throw failure{tls_error("Send")};
+
+        std::size_t have = 0;
+        while (have < status.size())
+        {
+          const int read = ::SSL_read(ssl, status.data() + have, status.size() - have);
+          if (read <= 0)
+            throw failure{tls_error("Receive")};
+          have += read;
+        }
+      }
+      else
+      {
+        sock.send_all(request);
+        sock.recv_all(status.data(), status.size());
+      }
+
+      if (std::string_view{status.data(), status.size()} != "HTTP/")
+        throw failure{"Server did not reply with HTTP"};
+    }
+
+    std::chrono::microseconds since(const clock::time_point start)
+    {
+      return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+    }
+
+    sample measure(SSL_CTX* ctx, const endpoint& server, const endpoint* proxy, const bool verify, const clock::time_point deadline)
+    {
+      sample out{};
+
+      auto start = clock::now();
+      const socket_ sock = tcp_connect(proxy ? *proxy : server, deadline);
+      if (proxy)
+        socks5_connect(sock, server);
+      out.connect = since(start);
+
+      ssl_stream ssl;
+      if (ctx)
+      {
+        start = clock::now();
+        ssl = tls_handshake(*ctx, sock, server, verify);
+        out.tls = since(start);
+      }
+
+      start = clock::now();
+      round_trip(sock, ssl.get(), server);
+      out.request = since(start);
+      return out;
+    }
+
+    //! Nearest-rank percentile of `values`, which is reordered
+    std::chrono::microseconds percentile(std::vector<std::chrono::microseconds>& values, const unsigned pct)
+    {
+      if (values.empty())
+        return {};
+      const std::size_t rank = std::max<std::size_t>(1, (values.size() * pct + 99) / 100) - 1;
+      std::nth_element(values.begin(), values.begin() + rank, values.end());
+      return values[rank];
+    }
+
+    percentiles summarize(const std::vector<sample>& samples, std::chrono::microseconds sample::* field)
+    {
+      std::vector<std::chrono::microseconds> values;
+      values.reserve(samples.size());
+      for (const sample& s : samples)
+        values.push_back(s.*field);
+      return {percentile(values, 50), percentile(values, 95)};
+    }
+  } // anonymous
+
+  probe_result probe(const std::string& url, const std::string& proxy, const bool verify, const unsigned count, const std::chrono::milliseconds timeout)
+  {
+    const block_sigpipe no_sigpipe{};
+    probe_result out{{}, 0, {}, {}, {}, {}};
+    const auto deadline = clock::now() + timeout;
+
+    try
+    {
+      const endpoint server = parse_url(url);
+      std::unique_ptr<endpoint> route;
+      if (!proxy.empty())
+        route = std::make_unique<endpoint>(parse_url(proxy, true));
+
+      ssl_context ctx;
+      if (server.tls)
+        ctx = make_context(verify);
+
+      out.samples.reserve(count);
+      for (unsigned i = 0; i < count; ++i)
+      {
+        if (clock::now() >= deadline)
+        {
+          out.failures += count - i;
+          if (out.error.empty())
+            out.error = "Timeout";
+          break;
+        }
+
+        try
+        {
+          out.samples.push_back(measure(ctx.get(), server, route.get(), verify, deadline));
+        }
+        catch (const failure& e)
+        {
+          ++out.failures;
+          out.error = e.what();
+        }
+      }
+    }
+    catch (const std::exception& e)
+    {
+      out.failures = count - out.samples.size();
+      out.error = e.what();
+    }
+
+    out.connect = summarize(out.samples, &sample::connect);
+    out.tls = summarize(out.samples, &sample::tls);
+    out.request = summarize(out.samples, &sample::request);
+    return out;
+  }
+}} // lwcli // net
@@ -0,0 +1,72 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "lwcli_config.h"
+
+namespace lwcli { namespace net
+{
+  //! Timings of one fresh connection. `tls` is zero for `http://` servers.
+  struct sample
+  {
+    std::chrono::microseconds connect; //!< DNS, TCP and SOCKS5 (if any)
+    std::chrono::microseconds tls;
+    std::chrono::microseconds request;  //!< Request sent to first response byte
+  };
+
+  struct percentiles
+  {
+    std::chrono::microseconds p50;
+    std::chrono::microseconds p95;
+  };
+
+  struct probe_result
+  {
+    std::vector<sample> samples; //!< Successful samples only
+    unsigned failures;
+    std::string error;           //!< Last failure, if any
+    percentiles connect;
+    percentiles tls;
+    percentiles request;
+  };
+
+  /*! Opens `count` sequential connections to the light-wallet server at
+    `url`, through the SOCKS5 `proxy` ("host:port") if not empty, and times
+    each stage of an HTTP request. TLS is used for `https://` URLs, and the
+    certificate is checked if `verify`. Connecting, TLS and the request are
+    bounded by `timeout` in total, and samples that do not finish in time
+    are failures. Name resolution is not bounded; it can take as long as the
+    system resolver allows. `SIGPIPE` is blocked on the calling thread while
+    this runs. */
+  probe_result probe(const std::string& url, const std::string& proxy, bool verify, unsigned count, std::chrono::milliseconds timeout = config::probe_timeout);
+}} // lwcli // net
@@ -0,0 +1,159 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "profile.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "util.h"
+
+namespace lwcli { namespace profile
+{
+  namespace
+  {
+    constexpr const std::string_view default_name{"default"};
+
+    //! Profile file names for the cache attributes in `config::wallet_store`
+    constexpr const std::array<std::pair<std::string_view, std::string_view>, 7> wallet_keys{{
+      {"server",          config::keys::url::name},
+      {"fallbacks",       config::keys::fallbacks::name},
+      {"proxy",           config::keys::proxy::name},
+      {"ssl",             config::keys::ssl::name},
+      {"refresh",         config::keys::refresh_interval::name},
+      {"major_lookahead", config::keys::major_lookahead::name},
+      {"minor_lookahead", config::keys::minor_lookahead::name}
+    }};
+
+    std::string_view trim(std::string_view value) noexcept
+    {
+      const auto space = [] (const char c) { return std::isspace(static_cast<unsigned char>(c)); };
+      while (!value.empty() && space(value.front()))
+        value.remove_prefix(1);
+      while (!value.empty() && space(value.back()))
+        value.remove_suffix(1);
+      return value;
+    }
+
+    //! "servers" is a pool: the first is the primary, the rest are fallbacks
+    void set_servers(config::wallet_store& out, const std::string_view pool)
+    {
+      const std::size_t split = pool.find_first_of(", \t");
+      out.set<config::keys::url>(std::string{pool.substr(0, split)});
+      if (split != std::string_view::npos)
+        out.set<config::keys::fallbacks>(std::string{trim(pool.substr(split + 1))});
+    }
+
+    //! \return False if `key` is unknown or `value` is invalid.
+    bool apply(settings& out, const std::string_view key, const std::string_view value)
+    {
+      if (key == "servers")
+      {
+        set_servers(out.wallet, value);
+        return !value.empty();
+      }
+      if (key == "timeout")
+      {
+        const auto seconds = from_string(value);
+        if (!seconds || std::uint64_t(std::numeric_limits<std::chrono::seconds::rep>::max()) < *seconds)
+          return false;
+        out.timeout = std::chrono::seconds{*seconds};
+        return true;
+      }
+
+      const auto mapped = std::find_if(wallet_keys.begin(), wallet_keys.end(), [key] (const auto& entry) {
+        return entry.first == key;
+      });
+      return mapped != wallet_keys.end() && out.wallet.set_text(mapped->second, value);
+    }
+  } // anonymous
+
+  std::string path()
+  {
+    const char* config = std::getenv("XDG_CONFIG_HOME");
+    if (config && *config)
+      return std::string{config} + "/lwcli/profiles";
+    const char* home = std::getenv("HOME");
+    return std::string{home ? home : ""} + "/.config/lwcli/profiles";
+  }
+
+  settings load(const std::string& name)
+  {
+    settings out{config::builtin_profile(), std::nullopt};
+    const std::string file = path();
+    const std::string_view wanted = name.empty() ? default_name : std::string_view{name};
+
+    std::ifstream in{file};
+    if (!in)
+    {
+      if (!name.empty())
+        throw std::runtime_error{"Unable to read profile file " + file};
+      return out;
+    }
+
+    bool found = false;
+    bool selected = false;
+    std::string line;
+    for (unsigned number = 1; std::getline(in, line); ++number)
+    {
+      const std::string_view entry = trim(line);
+      if (entry.empty() || entry.front() == '#' || entry.front() == ';')
+        continue;
+
+      const auto error = [&] (const char* what) {
+        return std::runtime_error{file + ":" + std::to_string(number) + ": " + what};
+      };
+
+      if (entry.front() == '[')
+      {
+        if (entry.back() != ']')
+          throw error("unterminated section name");
+        selected = trim(entry.substr(1, entry.size() - 2)) == wanted;
+        found |= selected;
+        continue;
+      }
+
+      const std::size_t equal = entry.find('=');
+      if (equal == std::string_view::npos)
+        throw error("expected key = value");
+      if (selected && !apply(out, trim(entry.substr(0, equal)), trim(entry.substr(equal + 1))))
+        throw error("unknown key or invalid value");
+    }
+
+    if (!found && !name.empty())
+      throw std::runtime_error{"No [" + name + "] profile in " + file};
+    return out;
+  }
+}} // lwcli // profile
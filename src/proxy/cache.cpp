@@ -0,0 +1,253 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "cache.h"
+
+namespace lwcli { namespace proxy
+{
+  std::vector<Monero::SubaddressRow*> cache::subaddress_proxy::getAll() const
+  {
+    return inner->getAll();
+  }
+
+  void cache::subaddress_proxy::addRow(const std::uint32_t accountIndex, const std::string& label)
+  {
+    inner->addRow(accountIndex, label);
+    self_.drop_labels();
+  }
+
+  void cache::subaddress_proxy::setLabel(const std::uint32_t accountIndex, const std::uint32_t addressIndex, const std::string& label)
+  {
+    inner->setLabel(accountIndex, addressIndex, label);
+    self_.drop_label(accountIndex, addressIndex);
+  }
+
+  void cache::subaddress_proxy::refresh(const std::uint32_t accountIndex)
+  {
+    inner->refresh(accountIndex);
+  }
+
+  std::vector<Monero::SubaddressAccountRow*> cache::account_proxy::getAll() const
+  {
+    return inner->getAll();
+  }
+
+  void cache::account_proxy::addRow(const std::string& label)
+  {
+    inner->addRow(label);
+    self_.drop_labels();
+  }
+
+  void cache::account_proxy::setLabel(const std::uint32_t accountIndex, const std::string& label)
+  {
+    inner->setLabel(accountIndex, label);
+    self_.drop_label(accountIndex, 0);
+  }
+
+  void cache::account_proxy::refresh()
+  {
+    inner->refresh();
+  }
+
+  void cache::listener_relay::moneySpent(const std::string& txId, const std::uint64_t amount)
+  {
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->moneySpent(txId, amount);
+  }
+
+  void cache::listener_relay::moneyReceived(const std::string& txId, const std::uint64_t amount)
+  {
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->moneyReceived(txId, amount);
+  }
+
+  void cache::listener_relay::unconfirmedMoneyReceived(const std::string& txId, const std::uint64_t amount)
+  {
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->unconfirmedMoneyReceived(txId, amount);
+  }
+
+  void cache::listener_relay::newBlock(const std::uint64_t height)
+  {
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->newBlock(height);
+  }
+
+  void cache::listener_relay::updated()
+  {
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->updated();
+  }
+
+  void cache::listener_relay::refreshed()
+  {
+    self_.drop_labels();
+    const std::lock_guard<std::mutex> lock{self_.listener_sync_};
+    if (self_.listener_)
+      self_.listener_->refreshed();
+  }
+
+  template<typename F>
+  std::string cache::get_key(const key which, F&& fetch) const
+  {
+    {
+      const std::lock_guard<std::mutex> lock{sync_};
+      if (keys_[which])
+        return *keys_[which];
+    }
+
+    // backend call made without the lock, a race only duplicates the fetch
+    std::string value = fetch();
+    const std::lock_guard<std::mutex> lock{sync_};
+    keys_[which] = value;
+    return value;
+  }
+
+  void cache::drop_label(const std::uint32_t accountIndex, const std::uint32_t addressIndex)
+  {
+    const std::lock_guard<std::mutex> lock{sync_};
+    labels_.erase({accountIndex, addressIndex});
+  }
+
+  void cache::drop_labels()
+  {
+    const std::lock_guard<std::mutex> lock{sync_};
+    labels_.clear();
+  }
+
+  cache::cache(std::shared_ptr<Monero::Wallet> wal)
+    : forward(std::move(wal)),
+      sync_(),
+      addresses_(),
+      labels_(),
+      keys_(),
+      listener_sync_(),
+      listener_(nullptr),
+      relay_(*this),
+      subaddress_(*this),
+      accounts_(*this)
+  {
+    forward::setListener(std::addressof(relay_));
+  }
+
+  cache::~cache()
+  {
+    forward::setListener(nullptr);
+  }
+
+  std::string cache::address(const std::uint32_t accountIndex, const std::uint32_t addressIndex) const
+  {
+    {
+      const std::lock_guard<std::mutex> lock{sync_};
+      const auto match = addresses_.find({accountIndex, addressIndex});
+      if (match != addresses_.end())
+        return match->second;
+    }
+
+    std::string value = forward::address(accountIndex, addressIndex);
+    if (value.empty())
+      return value; // invalid index or error, try again next time
+
+    const std::lock_guard<std::mutex> lock{sync_};
+    addresses_.try_emplace({accountIndex, addressIndex}, value);
+    return value;
+  }
+
+  std::string cache::publicViewKey() const
+  {
+    return get_key(public_view, [this] () { return forward::publicViewKey(); });
+  }
+
+  std::string cache::publicSpendKey() const
+  {
+    return get_key(public_spend, [this] () { return forward::publicSpendKey(); });
+  }
+
+  void cache::addSubaddressAccount(const std::string& label)
+  {
+    forward::addSubaddressAccount(label);
+    drop_labels();
+  }
+
+  void cache::addSubaddress(const std::uint32_t accountIndex, const std::string& label)
+  {
+    forward::addSubaddress(accountIndex, label);
+    drop_labels();
+  }
+
+  std::string cache::getSubaddressLabel(const std::uint32_t accountIndex, const std::uint32_t addressIndex) const
+  {
+    {
+      const std::lock_guard<std::mutex> lock{sync_};
+      const auto match = labels_.find({accountIndex, addressIndex});
+      if (match != labels_.end())
+        return match->second;
+    }
+
+    std::string value = forward::getSubaddressLabel(accountIndex, addressIndex);
+    const std::lock_guard<std::mutex> lock{sync_};
+    labels_.try_emplace({accountIndex, addressIndex}, value);
+    return value;
+  }
+
+  void cache::setSubaddressLabel(const std::uint32_t accountIndex, const std::uint32_t addressIndex, const std::string& label)
+  {
+    forward::setSubaddressLabel(accountIndex, addressIndex, label);
+    drop_label(accountIndex, addressIndex);
+  }
+
+  Monero::Subaddress* cache::subaddress()
+  {
+    Monero::Subaddress* const inner = forward::subaddress();
+    if (!inner)
+      return nullptr;
+    subaddress_.inner = inner;
+    return std::addressof(subaddress_);
+  }
+
+  Monero::SubaddressAccount* cache::subaddressAccount()
+  {
+    Monero::SubaddressAccount* const inner = forward::subaddressAccount();
+    if (!inner)
+      return nullptr;
+    accounts_.inner = inner;
+    return std::addressof(accounts_);
+  }
+
+  void cache::setListener(Monero::WalletListener* const listener)
+  {
+    // backend keeps calling `relay_`, the lock waits out a callback in progress
+    const std::lock_guard<std::mutex> lock{listener_sync_};
+    listener_ = listener;
+  }
+}} // lwcli // proxy
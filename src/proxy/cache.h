@@ -0,0 +1,139 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "proxy/forward.h"
+
+namespace lwcli { namespace proxy
+{
+  /*! Memoizes addresses, subaddress labels and public key strings. Labels
+    are dropped by the label/subaddress mutators (including through
+    `subaddress()` and `subaddressAccount()`) and on every `refreshed()` from
+    the backend. Addresses and keys are derived from the wallet keys and never
+    change. Secret keys are always forwarded, so no copy outlives the call. */
+  class cache final : public forward
+  {
+    class subaddress_proxy final : public Monero::Subaddress
+    {
+      cache& self_;
+
+    public:
+      Monero::Subaddress* inner;
+
+      explicit subaddress_proxy(cache& self) noexcept
+        : self_(self), inner(nullptr)
+      {}
+
+      std::vector<Monero::SubaddressRow*> getAll() const override final;
+      void addRow(std::uint32_t accountIndex, const std::string& label) override final;
+      void setLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label) override final;
+      void refresh(std::uint32_t accountIndex) override final;
+    };
+
+    class account_proxy final : public Monero::SubaddressAccount
+    {
+      cache& self_;
+
+    public:
+      Monero::SubaddressAccount* inner;
+
+      explicit account_proxy(cache& self) noexcept
+        : self_(self), inner(nullptr)
+      {}
+
+      std::vector<Monero::SubaddressAccountRow*> getAll() const override final;
+      void addRow(const std::string& label) override final;
+      void setLabel(std::uint32_t accountIndex, const std::string& label) override final;
+      void refresh() override final;
+    };
+
+    //! Registered with the backend so refreshes invalidate before the UI hears of them
+    class listener_relay final : public Monero::WalletListener
+    {
+      cache& self_;
+
+    public:
+      explicit listener_relay(cache& self) noexcept
+        : self_(self)
+      {}
+
+      void moneySpent(const std::string& txId, std::uint64_t amount) override final;
+      void moneyReceived(const std::string& txId, std::uint64_t amount) override final;
+      void unconfirmedMoneyReceived(const std::string& txId, std::uint64_t amount) override final;
+      void newBlock(std::uint64_t height) override final;
+      void updated() override final;
+      void refreshed() override final;
+    };
+
+    using index = std::pair<std::uint32_t, std::uint32_t>;
+    enum key { public_view = 0, public_spend, key_count };
+
+    mutable std::mutex sync_;
+    mutable std::map<index, std::string> addresses_;
+    mutable std::map<index, std::string> labels_;
+    mutable std::array<std::optional<std::string>, key_count> keys_;
+    std::mutex listener_sync_; //!< Held by `relay_` callbacks, separate so they can use the wallet
+    Monero::WalletListener* listener_;
+    listener_relay relay_;
+    subaddress_proxy subaddress_;
+    account_proxy accounts_;
+
+    template<typename F>
+    std::string get_key(key which, F&& fetch) const;
+
+    void drop_label(std::uint32_t accountIndex, std::uint32_t addressIndex);
+    void drop_labels();
+
+  public:
+    explicit cache(std::shared_ptr<Monero::Wallet> wal);
+    virtual ~cache() override;
+
+    std::string address(std::uint32_t accountIndex, std::uint32_t addressIndex) const override final;
+    std::string publicViewKey() const override final;
+    std::string publicSpendKey() const override final;
+
+    void addSubaddressAccount(const std::string& label) override final;
+    void addSubaddress(std::uint32_t accountIndex, const std::string& label) override final;
+    std::string getSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex) const override final;
+    void setSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label) override final;
+
+    Monero::Subaddress* subaddress() override final;
+    Monero::SubaddressAccount* subaddressAccount() override final;
+    void setListener(Monero::WalletListener* listener) override final;
+  };
+}} // lwcli // proxy
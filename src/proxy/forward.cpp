@@ -0,0 +1,862 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "forward.h"
+
+#include <stdexcept>
+
+namespace lwcli { namespace proxy
+{
+  std::int64_t forward::enter(const char*) const noexcept
+  {
+    return 0;
+  }
+
+  void forward::leave(const char*, std::int64_t) const noexcept
+  {}
+
+  forward::forward(std::shared_ptr<Monero::Wallet> wal)
+    : Monero::Wallet(), wal_(std::move(wal))
+  {
+    if (!wal_)
+      throw std::invalid_argument{"lwcli::proxy::forward given nullptr"};
+  }
+
+  forward::~forward()
+  {}
+
+  std::string forward::seed(const std::string& seed_offset) const
+  {
+    const call scope{*this, "seed"};
+    return wal_->seed(seed_offset);
+  }
+
+  std::string forward::getSeedLanguage() const
+  {
+    const call scope{*this, "getSeedLanguage"};
+    return wal_->getSeedLanguage();
+  }
+
+  void forward::setSeedLanguage(const std::string& language)
+  {
+    const call scope{*this, "setSeedLanguage"};
+    wal_->setSeedLanguage(language);
+  }
+
+  int forward::status() const
+  {
+    const call scope{*this, "status"};
+    return wal_->status();
+  }
+
+  std::string forward::errorString() const
+  {
+    const call scope{*this, "errorString"};
+    return wal_->errorString();
+  }
+
+  void forward::statusWithErrorString(int& status, std::string& errorString) const
+  {
+    const call scope{*this, "statusWithErrorString"};
+    wal_->statusWithErrorString(status, errorString);
+  }
+
+  bool forward::setPassword(const std::string& password)
+  {
+    const call scope{*this, "setPassword"};
+    return wal_->setPassword(password);
+  }
+
+  const std::string& forward::getPassword() const
+  {
+    const call scope{*this, "getPassword"};
+    return wal_->getPassword();
+  }
+
+  std::string forward::address(std::uint32_t accountIndex, std::uint32_t addressIndex) const
+  {
+    const call scope{*this, "address"};
+    return wal_->address(accountIndex, addressIndex);
+  }
+
+  std::string forward::path() const
+  {
+    const call scope{*this, "path"};
+    return wal_->path();
+  }
+
+  Monero::NetworkType forward::nettype() const
+  {
+    const call scope{*this, "nettype"};
+    return wal_->nettype();
+  }
+
+  void forward::hardForkInfo(std::uint8_t& version, std::uint64_t& earliest_height) const
+  {
+    const call scope{*this, "hardForkInfo"};
+    wal_->hardForkInfo(version, earliest_height);
+  }
+
+  bool forward::useForkRules(std::uint8_t version, std::int64_t early_blocks) const
+  {
+    const call scope{*this, "useForkRules"};
+    return wal_->useForkRules(version, early_blocks);
+  }
+
+  std::string forward::integratedAddress(const std::string& payment_id) const
+  {
+    const call scope{*this, "integratedAddress"};
+    return wal_->integratedAddress(payment_id);
+  }
+
+  std::string forward::secretViewKey() const
+  {
+    const call scope{*this, "secretViewKey"};
+    return wal_->secretViewKey();
+  }
+
+  std::string forward::publicViewKey() const
+  {
+    const call scope{*this, "publicViewKey"};
+    return wal_->publicViewKey();
+  }
+
+  std::string forward::secretSpendKey() const
+  {
+    const call scope{*this, "secretSpendKey"};
+    return wal_->secretSpendKey();
+  }
+
+  std::string forward::publicSpendKey() const
+  {
+    const call scope{*this, "publicSpendKey"};
+    return wal_->publicSpendKey();
+  }
+
+  std::string forward::publicMultisigSignerKey() const
+  {
+    const call scope{*this, "publicMultisigSignerKey"};
+    return wal_->publicMultisigSignerKey();
+  }
+
+  void forward::stop()
+  {
+    const call scope{*this, "stop"};
+    wal_->stop();
+  }
+
+  bool forward::store(const std::string& path)
+  {
+    const call scope{*this, "store"};
+    return wal_->store(path);
+  }
+
+  std::string forward::filename() const
+  {
+    const call scope{*this, "filename"};
+    return wal_->filename();
+  }
+
+  std::string forward::keysFilename() const
+  {
+    const call scope{*this, "keysFilename"};
+    return wal_->keysFilename();
+  }
+
+  bool forward::init(const std::string& daemon_address, std::uint64_t upper_transaction_size_limit, const std::string& daemon_username, const std::string& daemon_password, bool use_ssl, bool light_wallet, const std::string& proxy_address)
+  {
+    const call scope{*this, "init"};
+    return wal_->init(daemon_address, upper_transaction_size_limit, daemon_username, daemon_password, use_ssl, light_wallet, proxy_address);
+  }
+
+  bool forward::createWatchOnly(const std::string& path, const std::string& password, const std::string& language) const
+  {
+    const call scope{*this, "createWatchOnly"};
+    return wal_->createWatchOnly(path, password, language);
+  }
+
+  void forward::setRefreshFromBlockHeight(std::uint64_t refresh_from_block_height)
+  {
+    const call scope{*this, "setRefreshFromBlockHeight"};
+    wal_->setRefreshFromBlockHeight(refresh_from_block_height);
+  }
+
+  std::uint64_t forward::getRefreshFromBlockHeight() const
+  {
+    const call scope{*this, "getRefreshFromBlockHeight"};
+    return wal_->getRefreshFromBlockHeight();
+  }
+
+  void forward::setRecoveringFromSeed(bool recoveringFromSeed)
+  {
+    const call scope{*this, "setRecoveringFromSeed"};
+    wal_->setRecoveringFromSeed(recoveringFromSeed);
+  }
+
+  void forward::setRecoveringFromDevice(bool recoveringFromDevice)
+  {
+    const call scope{*this, "setRecoveringFromDevice"};
+    wal_->setRecoveringFromDevice(recoveringFromDevice);
+  }
+
+  void forward::setSubaddressLookahead(std::uint32_t major, std::uint32_t minor)
+  {
+    const call scope{*this, "setSubaddressLookahead"};
+    wal_->setSubaddressLookahead(major, minor);
+  }
+
+  bool forward::connectToDaemon()
+  {
+    const call scope{*this, "connectToDaemon"};
+    return wal_->connectToDaemon();
+  }
+
+  Monero::Wallet::ConnectionStatus forward::connected() const
+  {
+    const call scope{*this, "connected"};
+    return wal_->connected();
+  }
+
+  void forward::setTrustedDaemon(bool trusted)
+  {
+    const call scope{*this, "setTrustedDaemon"};
+    wal_->setTrustedDaemon(trusted);
+  }
+
+  bool forward::trustedDaemon() const
+  {
+    const call scope{*this, "trustedDaemon"};
+    return wal_->trustedDaemon();
+  }
+
+  bool forward::setProxy(const std::string& address)
+  {
+    const call scope{*this, "setProxy"};
+    return wal_->setProxy(address);
+  }
+
+  std::uint64_t forward::balance(std::uint32_t accountIndex) const
+  {
+    const call scope{*this, "balance"};
+    return wal_->balance(accountIndex);
+  }
+
+  std::uint64_t forward::unlockedBalance(std::uint32_t accountIndex) const
+  {
+    const call scope{*this, "unlockedBalance"};
+    return wal_->unlockedBalance(accountIndex);
+  }
+
+  bool forward::watchOnly() const
+  {
+    const call scope{*this, "watchOnly"};
+    return wal_->watchOnly();
+  }
+
+  bool forward::isDeterministic() const
+  {
+    const call scope{*this, "isDeterministic"};
+    return wal_->isDeterministic();
+  }
+
+  std::uint64_t forward::blockChainHeight() const
+  {
+    const call scope{*this, "blockChainHeight"};
+    return wal_->blockChainHeight();
+  }
+
+  std::uint64_t forward::approximateBlockChainHeight() const
+  {
+    const call scope{*this, "approximateBlockChainHeight"};
+    return wal_->approximateBlockChainHeight();
+  }
+
+  std::uint64_t forward::estimateBlockChainHeight() const
+  {
+    const call scope{*this, "estimateBlockChainHeight"};
+    return wal_->estimateBlockChainHeight();
+  }
+
+  std::uint64_t forward::daemonBlockChainHeight() const
+  {
+    const call scope{*this, "daemonBlockChainHeight"};
+    return wal_->daemonBlockChainHeight();
+  }
+
+  std::uint64_t forward::daemonBlockChainTargetHeight() const
+  {
+    const call scope{*this, "daemonBlockChainTargetHeight"};
+    return wal_->daemonBlockChainTargetHeight();
+  }
+
+  bool forward::synchronized() const
+  {
+    const call scope{*this, "synchronized"};
+    return wal_->synchronized();
+  }
+
+  void forward::startRefresh()
+  {
+    const call scope{*this, "startRefresh"};
+    wal_->startRefresh();
+  }
+
+  void forward::pauseRefresh()
+  {
+    const call scope{*this, "pauseRefresh"};
+    wal_->pauseRefresh();
+  }
+
+  bool forward::refresh()
+  {
+    const call scope{*this, "refresh"};
+    return wal_->refresh();
+  }
+
+  void forward::refreshAsync()
+  {
+    const call scope{*this, "refreshAsync"};
+    wal_->refreshAsync();
+  }
+
+  bool forward::rescanBlockchain()
+  {
+    const call scope{*this, "rescanBlockchain"};
+    return wal_->rescanBlockchain();
+  }
+
+  void forward::rescanBlockchainAsync()
+  {
+    const call scope{*this, "rescanBlockchainAsync"};
+    wal_->rescanBlockchainAsync();
+  }
+
+  void forward::setAutoRefreshInterval(int millis)
+  {
+    const call scope{*this, "setAutoRefreshInterval"};
+    wal_->setAutoRefreshInterval(millis);
+  }
+
+  int forward::autoRefreshInterval() const
+  {
+    const call scope{*this, "autoRefreshInterval"};
+    return wal_->autoRefreshInterval();
+  }
+
+  void forward::addSubaddressAccount(const std::string& label)
+  {
+    const call scope{*this, "addSubaddressAccount"};
+    wal_->addSubaddressAccount(label);
+  }
+
+  std::size_t forward::numSubaddressAccounts() const
+  {
+    const call scope{*this, "numSubaddressAccounts"};
+    return wal_->numSubaddressAccounts();
+  }
+
+  std::size_t forward::numSubaddresses(std::uint32_t accountIndex) const
+  {
+    const call scope{*this, "numSubaddresses"};
+    return wal_->numSubaddresses(accountIndex);
+  }
+
+  void forward::addSubaddress(std::uint32_t accountIndex, const std::string& label)
+  {
+    const call scope{*this, "addSubaddress"};
+    wal_->addSubaddress(accountIndex, label);
+  }
+
+  std::string forward::getSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex) const
+  {
+    const call scope{*this, "getSubaddressLabel"};
+    return wal_->getSubaddressLabel(accountIndex, addressIndex);
+  }
+
+  void forward::setSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label)
+  {
+    const call scope{*this, "setSubaddressLabel"};
+    wal_->setSubaddressLabel(accountIndex, addressIndex, label);
+  }
+
+  Monero::MultisigState forward::multisig() const
+  {
+    const call scope{*this, "multisig"};
+    return wal_->multisig();
+  }
+
+  std::string forward::getMultisigInfo() const
+  {
+    const call scope{*this, "getMultisigInfo"};
+    return wal_->getMultisigInfo();
+  }
+
+  std::string forward::makeMultisig(const std::vector<std::string>& info, std::uint32_t threshold)
+  {
+    const call scope{*this, "makeMultisig"};
+    return wal_->makeMultisig(info, threshold);
+  }
+
+  std::string forward::exchangeMultisigKeys(const std::vector<std::string>& info, const bool force_update_use_with_caution)
+  {
+    const call scope{*this, "exchangeMultisigKeys"};
+    return wal_->exchangeMultisigKeys(info, force_update_use_with_caution);
+  }
+
+  bool forward::exportMultisigImages(std::string& images)
+  {
+    const call scope{*this, "exportMultisigImages"};
+    return wal_->exportMultisigImages(images);
+  }
+
+  std::size_t forward::importMultisigImages(const std::vector<std::string>& images)
+  {
+    const call scope{*this, "importMultisigImages"};
+    return wal_->importMultisigImages(images);
+  }
+
+  bool forward::hasMultisigPartialKeyImages() const
+  {
+    const call scope{*this, "hasMultisigPartialKeyImages"};
+    return wal_->hasMultisigPartialKeyImages();
+  }
+
+  Monero::PendingTransaction* forward::restoreMultisigTransaction(const std::string& signData)
+  {
+    const call scope{*this, "restoreMultisigTransaction"};
+    return wal_->restoreMultisigTransaction(signData);
+  }
+
+  Monero::PendingTransaction* forward::createTransactionMultDest(const std::vector<std::string>& dst_addr, const std::string& payment_id, Monero::optional<std::vector<std::uint64_t>> amount, std::uint32_t mixin_count, Monero::PendingTransaction::Priority priority, std::uint32_t subaddr_account, std::set<std::uint32_t> subaddr_indices)
+  {
+    const call scope{*this, "createTransactionMultDest"};
+    return wal_->createTransactionMultDest(dst_addr, payment_id, std::move(amount), mixin_count, priority, subaddr_account, std::move(subaddr_indices));
+  }
+
+  Monero::PendingTransaction* forward::createTransaction(const std::string& dst_addr, const std::string& payment_id, Monero::optional<std::uint64_t> amount, std::uint32_t mixin_count, Monero::PendingTransaction::Priority priority, std::uint32_t subaddr_account, std::set<std::uint32_t> subaddr_indices)
+  {
+    const call scope{*this, "createTransaction"};
+    return wal_->createTransaction(dst_addr, payment_id, std::move(amount), mixin_count, priority, subaddr_account, std::move(subaddr_indices));
+  }
+
+  Monero::PendingTransaction* forward::createSweepUnmixableTransaction()
+  {
+    const call scope{*this, "createSweepUnmixableTransaction"};
+    return wal_->createSweepUnmixableTransaction();
+  }
+
+  Monero::UnsignedTransaction* forward::loadUnsignedTx(const std::string& unsigned_filename)
+  {
+    const call scope{*this, "loadUnsignedTx"};
+    return wal_->loadUnsignedTx(unsigned_filename);
+  }
+
+  bool forward::submitTransaction(const std::string& fileName)
+  {
+    const call scope{*this, "submitTransaction"};
+    return wal_->submitTransaction(fileName);
+  }
+
+  void forward::disposeTransaction(Monero::PendingTransaction* t)
+  {
+    const call scope{*this, "disposeTransaction"};
+    wal_->disposeTransaction(t);
+  }
+
+  std::uint64_t forward::estimateTransactionFee(const std::vector<std::pair<std::string, std::uint64_t>>& destinations, Monero::PendingTransaction::Priority priority) const
+  {
+    const call scope{*this, "estimateTransactionFee"};
+    return wal_->estimateTransactionFee(destinations, priority);
+  }
+
+  bool forward::exportKeyImages(const std::string& filename, bool all)
+  {
+    const call scope{*this, "exportKeyImages"};
+    return wal_->exportKeyImages(filename, all);
+  }
+
+  bool forward::importKeyImages(const std::string& filename)
+  {
+    const call scope{*this, "importKeyImages"};
+    return wal_->importKeyImages(filename);
+  }
+
+  bool forward::exportOutputs(const std::string& filename, bool all)
+  {
+    const call scope{*this, "exportOutputs"};
+    return wal_->exportOutputs(filename, all);
+  }
+
+  bool forward::importOutputs(const std::string& filename)
+  {
+    const call scope{*this, "importOutputs"};
+    return wal_->importOutputs(filename);
+  }
+
+  bool forward::scanTransactions(const std::vector<std::string>& txids)
+  {
+    const call scope{*this, "scanTransactions"};
+    return wal_->scanTransactions(txids);
+  }
+
+  bool forward::setupBackgroundSync(const BackgroundSyncType background_sync_type, const std::string& wallet_password, const Monero::optional<std::string>& background_cache_password)
+  {
+    const call scope{*this, "setupBackgroundSync"};
+    return wal_->setupBackgroundSync(background_sync_type, wallet_password, background_cache_password);
+  }
+
+  Monero::Wallet::BackgroundSyncType forward::getBackgroundSyncType() const
+  {
+    const call scope{*this, "getBackgroundSyncType"};
+    return wal_->getBackgroundSyncType();
+  }
+
+  bool forward::startBackgroundSync()
+  {
+    const call scope{*this, "startBackgroundSync"};
+    return wal_->startBackgroundSync();
+  }
+
+  bool forward::stopBackgroundSync(const std::string& wallet_password)
+  {
+    const call scope{*this, "stopBackgroundSync"};
+    return wal_->stopBackgroundSync(wallet_password);
+  }
+
+  bool forward::isBackgroundSyncing() const
+  {
+    const call scope{*this, "isBackgroundSyncing"};
+    return wal_->isBackgroundSyncing();
+  }
+
+  bool forward::isBackgroundWallet() const
+  {
+    const call scope{*this, "isBackgroundWallet"};
+    return wal_->isBackgroundWallet();
+  }
+
+  Monero::TransactionHistory* forward::history()
+  {
+    const call scope{*this, "history"};
+    return wal_->history();
+  }
+
+  Monero::AddressBook* forward::addressBook()
+  {
+    const call scope{*this, "addressBook"};
+    return wal_->addressBook();
+  }
+
+  Monero::Coins* forward::coins()
+  {
+    const call scope{*this, "coins"};
+    return wal_->coins();
+  }
+
+  Monero::Subaddress* forward::subaddress()
+  {
+    const call scope{*this, "subaddress"};
+    return wal_->subaddress();
+  }
+
+  Monero::SubaddressAccount* forward::subaddressAccount()
+  {
+    const call scope{*this, "subaddressAccount"};
+    return wal_->subaddressAccount();
+  }
+
+  void forward::setListener(Monero::WalletListener* listener)
+  {
+    const call scope{*this, "setListener"};
+    wal_->setListener(listener);
+  }
+
+  std::uint32_t forward::defaultMixin() const
+  {
+    const call scope{*this, "defaultMixin"};
+    return wal_->defaultMixin();
+  }
+
+  void forward::setDefaultMixin(std::uint32_t mixin)
+  {
+    const call scope{*this, "setDefaultMixin"};
+    wal_->setDefaultMixin(mixin);
+  }
+
+  bool forward::setCacheAttribute(const std::string& key, const std::string& val)
+  {
+    const call scope{*this, "setCacheAttribute"};
+    return wal_->setCacheAttribute(key, val);
+  }
+
+  std::string forward::getCacheAttribute(const std::string& key) const
+  {
+    const call scope{*this, "getCacheAttribute"};
+    return wal_->getCacheAttribute(key);
+  }
+
+  bool forward::setUserNote(const std::string& txid, const std::string& note)
+  {
+    const call scope{*this, "setUserNote"};
+    return wal_->setUserNote(txid, note);
+  }
+
+  std::string forward::getUserNote(const std::string& txid) const
+  {
+    const call scope{*this, "getUserNote"};
+    return wal_->getUserNote(txid);
+  }
+
+  std::string forward::getTxKey(const std::string& txid) const
+  {
+    const call scope{*this, "getTxKey"};
+    return wal_->getTxKey(txid);
+  }
+
+  bool forward::checkTxKey(const std::string& txid, std::string tx_key, const std::string& address, std::uint64_t& received, bool& in_pool, std::uint64_t& confirmations)
+  {
+    const call scope{*this, "checkTxKey"};
+    return wal_->checkTxKey(txid, std::move(tx_key), address, received, in_pool, confirmations);
+  }
+
+  std::string forward::getTxProof(const std::string& txid, const std::string& address, const std::string& message) const
+  {
+    const call scope{*this, "getTxProof"};
+    return wal_->getTxProof(txid, address, message);
+  }
+
+  bool forward::checkTxProof(const std::string& txid, const std::string& address, const std::string& message, const std::string& signature, bool& good, std::uint64_t& received, bool& in_pool, std::uint64_t& confirmations)
+  {
+    const call scope{*this, "checkTxProof"};
+    return wal_->checkTxProof(txid, address, message, signature, good, received, in_pool, confirmations);
+  }
+
+  std::string forward::getSpendProof(const std::string& txid, const std::string& message) const
+  {
+    const call scope{*this, "getSpendProof"};
+    return wal_->getSpendProof(txid, message);
+  }
+
+  bool forward::checkSpendProof(const std::string& txid, const std::string& message, const std::string& signature, bool& good) const
+  {
+    const call scope{*this, "checkSpendProof"};
+    return wal_->checkSpendProof(txid, message, signature, good);
+  }
+
+  std::string forward::getReserveProof(bool all, std::uint32_t account_index, std::uint64_t amount, const std::string& message) const
+  {
+    const call scope{*this, "getReserveProof"};
+    return wal_->getReserveProof(all, account_index, amount, message);
+  }
+
+  bool forward::checkReserveProof(const std::string& address, const std::string& message, const std::string& signature, bool& good, std::uint64_t& total, std::uint64_t& spent) const
+  {
+    const call scope{*this, "checkReserveProof"};
+    return wal_->checkReserveProof(address, message, signature, good, total, spent);
+  }
+
+  std::string forward::signMessage(const std::string& message, const std::string& address)
+  {
+    const call scope{*this, "signMessage"};
+    return wal_->signMessage(message, address);
+  }
+
+  bool forward::verifySignedMessage(const std::string& message, const std::string& address, const std::string& signature) const
+  {
+    const call scope{*this, "verifySignedMessage"};
+    return wal_->verifySignedMessage(message, address, signature);
+  }
+
+  std::string forward::signMultisigParticipant(const std::string& message) const
+  {
+    const call scope{*this, "signMultisigParticipant"};
+    return wal_->signMultisigParticipant(message);
+  }
+
+  bool forward::verifyMessageWithPublicKey(const std::string& message, const std::string& publicKey, const std::string& signature) const
+  {
+    const call scope{*this, "verifyMessageWithPublicKey"};
+    return wal_->verifyMessageWithPublicKey(message, publicKey, signature);
+  }
+
+  bool forward::parse_uri(const std::string& uri, std::string& address, std::string& payment_id, std::uint64_t& amount, std::string& tx_description, std::string& recipient_name, std::vector<std::string>& unknown_parameters, std::string& error)
+  {
+    const call scope{*this, "parse_uri"};
+    return wal_->parse_uri(uri, address, payment_id, amount, tx_description, recipient_name, unknown_parameters, error);
+  }
+
+  std::string forward::make_uri(const std::string& address, const std::string& payment_id, std::uint64_t amount, const std::string& tx_description, const std::string& recipient_name, std::string& error) const
+  {
+    const call scope{*this, "make_uri"};
+    return wal_->make_uri(address, payment_id, amount, tx_description, recipient_name, error);
+  }
+
+  std::string forward::getDefaultDataDir() const
+  {
+    const call scope{*this, "getDefaultDataDir"};
+    return wal_->getDefaultDataDir();
+  }
+
+  bool forward::rescanSpent()
+  {
+    const call scope{*this, "rescanSpent"};
+    return wal_->rescanSpent();
+  }
+
+  void forward::setOffline(bool offline)
+  {
+    const call scope{*this, "setOffline"};
+    wal_->setOffline(offline);
+  }
+
+  bool forward::isOffline() const
+  {
+    const call scope{*this, "isOffline"};
+    return wal_->isOffline();
+  }
+
+  bool forward::blackballOutputs(const std::vector<std::string>& outputs, bool add)
+  {
+    const call scope{*this, "blackballOutputs"};
+    return wal_->blackballOutputs(outputs, add);
+  }
+
+  bool forward::blackballOutput(const std::string& amount, const std::string& offset)
+  {
+    const call scope{*this, "blackballOutput"};
+    return wal_->blackballOutput(amount, offset);
+  }
+
+  bool forward::unblackballOutput(const std::string& amount, const std::string& offset)
+  {
+    const call scope{*this, "unblackballOutput"};
+    return wal_->unblackballOutput(amount, offset);
+  }
+
+  bool forward::getRing(const std::string& key_image, std::vector<std::uint64_t>& ring) const
+  {
+    const call scope{*this, "getRing"};
+    return wal_->getRing(key_image, ring);
+  }
+
+  bool forward::getRings(const std::string& txid, std::vector<std::pair<std::string, std::vector<std::uint64_t>>>& rings) const
+  {
+    const call scope{*this, "getRings"};
+    return wal_->getRings(txid, rings);
+  }
+
+  bool forward::setRing(const std::string& key_image, const std::vector<std::uint64_t>& ring, bool relative)
+  {
+    const call scope{*this, "setRing"};
+    return wal_->setRing(key_image, ring, relative);
+  }
+
+  void forward::segregatePreForkOutputs(bool segregate)
+  {
+    const call scope{*this, "segregatePreForkOutputs"};
+    wal_->segregatePreForkOutputs(segregate);
+  }
+
+  void forward::segregationHeight(std::uint64_t height)
+  {
+    const call scope{*this, "segregationHeight"};
+    wal_->segregationHeight(height);
+  }
+
+  void forward::keyReuseMitigation2(bool mitigation)
+  {
+    const call scope{*this, "keyReuseMitigation2"};
+    wal_->keyReuseMitigation2(mitigation);
+  }
+
+  bool forward::lightWalletLogin(bool& isNewWallet) const
+  {
+    const call scope{*this, "lightWalletLogin"};
+    return wal_->lightWalletLogin(isNewWallet);
+  }
+
+  bool forward::lightWalletImportWalletRequest(std::string& payment_id, std::uint64_t& fee, bool& new_request, bool& request_fulfilled, std::string& payment_address, std::string& status)
+  {
+    const call scope{*this, "lightWalletImportWalletRequest"};
+    return wal_->lightWalletImportWalletRequest(payment_id, fee, new_request, request_fulfilled, payment_address, status);
+  }
+
+  bool forward::lockKeysFile()
+  {
+    const call scope{*this, "lockKeysFile"};
+    return wal_->lockKeysFile();
+  }
+
+  bool forward::unlockKeysFile()
+  {
+    const call scope{*this, "unlockKeysFile"};
+    return wal_->unlockKeysFile();
+  }
+
+  bool forward::isKeysFileLocked()
+  {
+    const call scope{*this, "isKeysFileLocked"};
+    return wal_->isKeysFileLocked();
+  }
+
+  Monero::Wallet::Device forward::getDeviceType() const
+  {
+    const call scope{*this, "getDeviceType"};
+    return wal_->getDeviceType();
+  }
+
+  std::uint64_t forward::coldKeyImageSync(std::uint64_t& spent, std::uint64_t& unspent)
+  {
+    const call scope{*this, "coldKeyImageSync"};
+    return wal_->coldKeyImageSync(spent, unspent);
+  }
+
+  void forward::deviceShowAddress(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& paymentId)
+  {
+    const call scope{*this, "deviceShowAddress"};
+    wal_->deviceShowAddress(accountIndex, addressIndex, paymentId);
+  }
+
+  bool forward::reconnectDevice()
+  {
+    const call scope{*this, "reconnectDevice"};
+    return wal_->reconnectDevice();
+  }
+
+  std::uint64_t forward::getBytesReceived()
+  {
+    const call scope{*this, "getBytesReceived"};
+    return wal_->getBytesReceived();
+  }
+
+  std::uint64_t forward::getBytesSent()
+  {
+    const call scope{*this, "getBytesSent"};
+    return wal_->getBytesSent();
+  }
+}} // lwcli // proxy
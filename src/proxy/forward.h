@@ -0,0 +1,235 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <lws_frontend.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace lwcli { namespace proxy
+{
+  /*! `Monero::Wallet` that passes every call to another wallet. Decorators
+    derive from this and override only the calls they care about, or hook
+    `enter`/`leave` to observe all of them. */
+  class forward : public Monero::Wallet
+  {
+  protected:
+    const std::shared_ptr<Monero::Wallet> wal_;
+
+    //! Brackets one forwarded call with `enter`/`leave`.
+    class call
+    {
+      const forward& self_;
+      const char* const name_;
+      const std::int64_t token_;
+
+    public:
+      call(const forward& self, const char* name) noexcept
+        : self_(self), name_(name), token_(self.enter(name))
+      {}
+
+      ~call() noexcept { self_.leave(name_, token_); }
+
+      call(const call&) = delete;
+      call& operator=(const call&) = delete;
+    };
+
+    /*! Called before every forwarded call. `name` is a string literal.
+      \return Value given to the matching `leave`. */
+    virtual std::int64_t enter(const char* name) const noexcept;
+
+    //! Called after every forwarded call, including when it throws.
+    virtual void leave(const char* name, std::int64_t token) const noexcept;
+
+  public:
+    explicit forward(std::shared_ptr<Monero::Wallet> wal);
+    virtual ~forward() override;
+
+    forward(const forward&) = delete;
+    forward& operator=(const forward&) = delete;
+
+    //! \return Wallet receiving the calls
+    const std::shared_ptr<Monero::Wallet>& target() const noexcept { return wal_; }
+
+    std::string seed(const std::string& seed_offset) const override;
+    std::string getSeedLanguage() const override;
+    void setSeedLanguage(const std::string& language) override;
+    int status() const override;
+    std::string errorString() const override;
+    void statusWithErrorString(int& status, std::string& errorString) const override;
+    bool setPassword(const std::string& password) override;
+    const std::string& getPassword() const override;
+    std::string address(std::uint32_t accountIndex, std::uint32_t addressIndex) const override;
+    std::string path() const override;
+    Monero::NetworkType nettype() const override;
+    void hardForkInfo(std::uint8_t& version, std::uint64_t& earliest_height) const override;
+    bool useForkRules(std::uint8_t version, std::int64_t early_blocks) const override;
+    std::string integratedAddress(const std::string& payment_id) const override;
+    std::string secretViewKey() const override;
+    std::string publicViewKey() const override;
+    std::string secretSpendKey() const override;
+    std::string publicSpendKey() const override;
+    std::string publicMultisigSignerKey() const override;
+    void stop() override;
+    bool store(const std::string& path) override;
+    std::string filename() const override;
+    std::string keysFilename() const override;
+    bool init(const std::string& daemon_address, std::uint64_t upper_transaction_size_limit, const std::string& daemon_username, const std::string& daemon_password, bool use_ssl, bool light_wallet, const std::string& proxy_address) override;
+    bool createWatchOnly(const std::string& path, const std::string& password, const std::string& language) const override;
+    void setRefreshFromBlockHeight(std::uint64_t refresh_from_block_height) override;
+    std::uint64_t getRefreshFromBlockHeight() const override;
+    void setRecoveringFromSeed(bool recoveringFromSeed) override;
+    void setRecoveringFromDevice(bool recoveringFromDevice) override;
+    void setSubaddressLookahead(std::uint32_t major, std::uint32_t minor) override;
+    bool connectToDaemon() override;
+    ConnectionStatus connected() const override;
+    void setTrustedDaemon(bool trusted) override;
+    bool trustedDaemon() const override;
+    bool setProxy(const std::string& address) override;
+    std::uint64_t balance(std::uint32_t accountIndex) const override;
+    std::uint64_t unlockedBalance(std::uint32_t accountIndex) const override;
+    bool watchOnly() const override;
+    bool isDeterministic() const override;
+    std::uint64_t blockChainHeight() const override;
+    std::uint64_t approximateBlockChainHeight() const override;
+    std::uint64_t estimateBlockChainHeight() const override;
+    std::uint64_t daemonBlockChainHeight() const override;
+    std::uint64_t daemonBlockChainTargetHeight() const override;
+    bool synchronized() const override;
+    void startRefresh() override;
+    void pauseRefresh() override;
+    bool refresh() override;
+    void refreshAsync() override;
+    bool rescanBlockchain() override;
+    void rescanBlockchainAsync() override;
+    void setAutoRefreshInterval(int millis) override;
+    int autoRefreshInterval() const override;
+    void addSubaddressAccount(const std::string& label) override;
+    std::size_t numSubaddressAccounts() const override;
+    std::size_t numSubaddresses(std::uint32_t accountIndex) const override;
+    void addSubaddress(std::uint32_t accountIndex, const std::string& label) override;
+    std::string getSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex) const override;
+    void setSubaddressLabel(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& label) override;
+    Monero::MultisigState multisig() const override;
+    std::string getMultisigInfo() const override;
+    std::string makeMultisig(const std::vector<std::string>& info, std::uint32_t threshold) override;
+    std::string exchangeMultisigKeys(const std::vector<std::string>& info, const bool force_update_use_with_caution) override;
+    bool exportMultisigImages(std::string& images) override;
+    std::size_t importMultisigImages(const std::vector<std::string>& images) override;
+    bool hasMultisigPartialKeyImages() const override;
+    Monero::PendingTransaction* restoreMultisigTransaction(const std::string& signData) override;
+    Monero::PendingTransaction* createTransactionMultDest(const std::vector<std::string>& dst_addr, const std::string& payment_id, Monero::optional<std::vector<std::uint64_t>> amount, std::uint32_t mixin_count, Monero::PendingTransaction::Priority priority, std::uint32_t subaddr_account, std::set<std::uint32_t> subaddr_indices) override;
+    Monero::PendingTransaction* createTransaction(const std::string& dst_addr, const std::string& payment_id, Monero::optional<std::uint64_t> amount, std::uint32_t mixin_count, Monero::PendingTransaction::Priority priority, std::uint32_t subaddr_account, std::set<std::uint32_t> subaddr_indices) override;
+    Monero::PendingTransaction* createSweepUnmixableTransaction() override;
+    Monero::UnsignedTransaction* loadUnsignedTx(const std::string& unsigned_filename) override;
+    bool submitTransaction(const std::string& fileName) override;
+    void disposeTransaction(Monero::PendingTransaction* t) override;
+    std::uint64_t estimateTransactionFee(const std::vector<std::pair<std::string, std::uint64_t>>& destinations, Monero::PendingTransaction::Priority priority) const override;
+    bool exportKeyImages(const std::string& filename, bool all) override;
+    bool importKeyImages(const std::string& filename) override;
+    bool exportOutputs(const std::string& filename, bool all) override;
+    bool importOutputs(const std::string& filename) override;
+    bool scanTransactions(const std::vector<std::string>& txids) override;
+    bool setupBackgroundSync(const BackgroundSyncType background_sync_type, const std::string& wallet_password, const Monero::optional<std::string>& background_cache_password) override;
+    BackgroundSyncType getBackgroundSyncType() const override;
+    bool startBackgroundSync() override;
+    bool stopBackgroundSync(const std::string& wallet_password) override;
+    bool isBackgroundSyncing() const override;
+    bool isBackgroundWallet() const override;
+    Monero::TransactionHistory* history() override;
+    Monero::AddressBook* addressBook() override;
+    Monero::Coins* coins() override;
+    Monero::Subaddress* subaddress() override;
+    Monero::SubaddressAccount* subaddressAccount() override;
+    void setListener(Monero::WalletListener* listener) override;
+    std::uint32_t defaultMixin() const override;
+    void setDefaultMixin(std::uint32_t mixin) override;
+    bool setCacheAttribute(const std::string& key, const std::string& val) override;
+    std::string getCacheAttribute(const std::string& key) const override;
+    bool setUserNote(const std::string& txid, const std::string& note) override;
+    std::string getUserNote(const std::string& txid) const override;
+    std::string getTxKey(const std::string& txid) const override;
+    bool checkTxKey(const std::string& txid, std::string tx_key, const std::string& address, std::uint64_t& received, bool& in_pool, std::uint64_t& confirmations) override;
+    std::string getTxProof(const std::string& txid, const std::string& address, const std::string& message) const override;
+    bool checkTxProof(const std::string& txid, const std::string& address, const std::string& message, const std::string& signature, bool& good, std::uint64_t& received, bool& in_pool, std::uint64_t& confirmations) override;
+    std::string getSpendProof(const std::string& txid, const std::string& message) const override;
+    bool checkSpendProof(const std::string& txid, const std::string& message, const std::string& signature, bool& good) const override;
+    std::string getReserveProof(bool all, std::uint32_t account_index, std::uint64_t amount, const std::string& message) const override;
+    bool checkReserveProof(const std::string& address, const std::string& message, const std::string& signature, bool& good, std::uint64_t& total, std::uint64_t& spent) const override;
+    std::string signMessage(const std::string& message, const std::string& address) override;
+    bool verifySignedMessage(const std::string& message, const std::string& address, const std::string& signature) const override;
+    std::string signMultisigParticipant(const std::string& message) const override;
+    bool verifyMessageWithPublicKey(const std::string& message, const std::string& publicKey, const std::string& signature) const override;
+    bool parse_uri(const std::string& uri, std::string& address, std::string& payment_id, std::uint64_t& amount, std::string& tx_description, std::string& recipient_name, std::vector<std::string>& unknown_parameters, std::string& error) override;
+    std::string make_uri(const std::string& address, const std::string& payment_id, std::uint64_t amount, const std::string& tx_description, const std::string& recipient_name, std::string& error) const override;
+    std::string getDefaultDataDir() const override;
+    bool rescanSpent() override;
+    void setOffline(bool offline) override;
+    bool isOffline() const override;
+    bool blackballOutputs(const std::vector<std::string>& outputs, bool add) override;
+    bool blackballOutput(const std::string& amount, const std::string& offset) override;
+    bool unblackballOutput(const std::string& amount, const std::string& offset) override;
+    bool getRing(const std::string& key_image, std::vector<std::uint64_t>& ring) const override;
+    bool getRings(const std::string& txid, std::vector<std::pair<std::string, std::vector<std::uint64_t>>>& rings) const override;
+    bool setRing(const std::string& key_image, const std::vector<std::uint64_t>& ring, bool relative) override;
+    void segregatePreForkOutputs(bool segregate) override;
+    void segregationHeight(std::uint64_t height) override;
+    void keyReuseMitigation2(bool mitigation) override;
+    bool lightWalletLogin(bool& isNewWallet) const override;
+    bool lightWalletImportWalletRequest(std::string& payment_id, std::uint64_t& fee, bool& new_request, bool& request_fulfilled, std::string& payment_address, std::string& status) override;
+    bool lockKeysFile() override;
+    bool unlockKeysFile() override;
+    bool isKeysFileLocked() override;
+    Device getDeviceType() const override;
+    std::uint64_t coldKeyImageSync(std::uint64_t& spent, std::uint64_t& unspent) override;
+    void deviceShowAddress(std::uint32_t accountIndex, std::uint32_t addressIndex, const std::string& paymentId) override;
+    bool reconnectDevice() override;
+    std::uint64_t getBytesReceived() override;
+    std::uint64_t getBytesSent() override;
+  };
+
+  //! \return First `T` in the chain of `forward` wallets starting at `wal`, or `nullptr`.
+  template<typename T>
+  std::shared_ptr<T> find(std::shared_ptr<Monero::Wallet> wal)
+  {
+    while (wal)
+    {
+      if (auto out = std::dynamic_pointer_cast<T>(wal))
+        return out;
+      const auto next = std::dynamic_pointer_cast<forward>(wal);
+      if (!next)
+        break;
+      wal = next->target();
+    }
+    return nullptr;
+  }
+}} // lwcli // proxy
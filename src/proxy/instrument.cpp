@@ -0,0 +1,115 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "instrument.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace lwcli { namespace proxy
+{
+  namespace
+  {
+    std::int64_t now() noexcept
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count();
+    }
+
+    std::size_t get_bucket(std::uint64_t ns) noexcept
+    {
+      std::size_t bucket = 0;
+      for (std::uint64_t limit = 1000; limit <= ns && bucket < call_stats::buckets - 1; limit *= 4)
+        ++bucket;
+      return bucket;
+    }
+  }
+
+  std::int64_t instrument::enter(const char*) const noexcept
+  {
+    return enabled() ? now() : -1;
+  }
+
+  void instrument::leave(const char* name, const std::int64_t token) const noexcept
+  {
+    if (token < 0)
+      return;
+
+    const std::uint64_t elapsed = std::max<std::int64_t>(0, now() - token);
+    const std::thread::id thread = std::this_thread::get_id();
+    try
+    {
+      const std::lock_guard<std::mutex> lock{sync_};
+      call_stats& stats = stats_[name];
+      stats.name = name;
+      ++stats.count;
+      if (thread == ui_thread_)
+        ++stats.ui_count;
+      stats.total_ns += elapsed;
+      stats.max_ns = std::max(stats.max_ns, elapsed);
+      ++stats.histogram[get_bucket(elapsed)];
+      if (std::find(stats.threads.begin(), stats.threads.end(), thread) == stats.threads.end())
+        stats.threads.push_back(thread);
+    }
+    catch (...)
+    {} // drop sample on allocation failure
+  }
+
+  instrument::instrument(std::shared_ptr<Monero::Wallet> wal)
+    : forward(std::move(wal)),
+      sync_(),
+      stats_(),
+      ui_thread_(std::this_thread::get_id()),
+      enabled_(true)
+  {}
+
+  instrument::~instrument()
+  {}
+
+  void instrument::reset()
+  {
+    const std::lock_guard<std::mutex> lock{sync_};
+    stats_.clear();
+  }
+
+  std::vector<call_stats> instrument::snapshot() const
+  {
+    std::vector<call_stats> out;
+    {
+      const std::lock_guard<std::mutex> lock{sync_};
+      out.reserve(stats_.size());
+      for (const auto& entry : stats_)
+        out.push_back(entry.second);
+    }
+    std::sort(out.begin(), out.end(), [] (const call_stats& lhs, const call_stats& rhs) {
+      return rhs.total_ns < lhs.total_ns;
+    });
+    return out;
+  }
+}} // lwcli // proxy
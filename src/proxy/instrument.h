@@ -0,0 +1,84 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "proxy/forward.h"
+
+namespace lwcli { namespace proxy
+{
+  //! Recorded activity for one `Monero::Wallet` method.
+  struct call_stats
+  {
+    //! Latency buckets grow by 4x from 1us: [0,1us), [1us,4us) ... [262ms,inf)
+    static constexpr const std::size_t buckets = 11;
+
+    const char* name = nullptr;
+    std::uint64_t count = 0;
+    std::uint64_t ui_count = 0; //!< calls from the thread that created the proxy
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns = 0;
+    std::array<std::uint64_t, buckets> histogram{};
+    std::vector<std::thread::id> threads;
+  };
+
+  /*! Forwards every call and records count, latency histogram and calling
+    thread per method. Recording can be toggled at any time. */
+  class instrument final : public forward
+  {
+    mutable std::mutex sync_;
+    mutable std::unordered_map<const char*, call_stats> stats_;
+    const std::thread::id ui_thread_;
+    std::atomic<bool> enabled_;
+
+    std::int64_t enter(const char* name) const noexcept override final;
+    void leave(const char* name, std::int64_t token) const noexcept override final;
+
+  public:
+    //! Must be constructed on the UI thread.
+    explicit instrument(std::shared_ptr<Monero::Wallet> wal);
+    virtual ~instrument() override;
+
+    bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+    void enable(bool on) noexcept { enabled_.store(on, std::memory_order_relaxed); }
+
+    void reset();
+
+    //! \return Copy of all stats, most total time first.
+    std::vector<call_stats> snapshot() const;
+  };
+}} // lwcli // proxy
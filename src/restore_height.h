@@ -0,0 +1,146 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "lws_frontend.h"
+#include "util.h"
+
+namespace lwcli { namespace restore
+{
+  struct checkpoint
+  {
+    std::uint64_t height;
+    std::uint64_t timestamp;
+  };
+
+  //! Average seconds per block after the v2 hard fork
+  constexpr const std::uint64_t block_time = 120;
+
+  //! Blocks subtracted from every estimate (~1 week), covers checkpoint error
+  constexpr const std::uint64_t safety_margin = 5040;
+
+  /* The v2 fork entries match the estimate used by wallet2. Later entries are
+  hard fork heights with timestamps rounded to the day of the fork; interpolation
+  between them is only as accurate as `safety_margin` allows. */
+  constexpr const std::array<checkpoint, 5> mainnet{{
+    {1,       1397818193},
+    {1009827, 1458748658},
+    {1978433, 1575072000},
+    {2210720, 1602979200},
+    {2688888, 1660348800}
+  }};
+
+  constexpr const std::array<checkpoint, 1> testnet{{
+    {624634, 1448285909}
+  }};
+
+  constexpr const std::array<checkpoint, 1> stagenet{{
+    {32000, 1520937818}
+  }};
+
+  //! \return Estimated height at `timestamp` using `points`, before margin.
+  template<std::size_t N>
+  constexpr std::uint64_t estimate(const std::array<checkpoint, N>& points, const std::uint64_t timestamp) noexcept
+  {
+    std::size_t i = 0;
+    for ( ; i < points.size() && points[i].timestamp <= timestamp; ++i);
+
+    if (i == 0)
+      return 0; // before first checkpoint, scan everything
+
+    const checkpoint& last = points[i - 1];
+    const std::uint64_t elapsed = timestamp - last.timestamp;
+    if (i == points.size())
+      return last.height + elapsed / block_time;
+
+    const checkpoint& next = points[i];
+    const std::uint64_t span = next.timestamp - last.timestamp;
+    return last.height + ((next.height - last.height) * elapsed) / span;
+  }
+
+  //! \return Safe restore height for a wallet created at `timestamp` on `network`.
+  constexpr std::uint64_t height(const Monero::NetworkType network, const std::uint64_t timestamp) noexcept
+  {
+    std::uint64_t out = 0;
+    switch (network)
+    {
+      default:
+      case Monero::MAINNET:
+        out = estimate(mainnet, timestamp);
+        break;
+      case Monero::TESTNET:
+        out = estimate(testnet, timestamp);
+        break;
+      case Monero::STAGENET:
+        out = estimate(stagenet, timestamp);
+        break;
+    }
+    return out < safety_margin ? 0 : out - safety_margin;
+  }
+
+  //! \return Days since unix epoch for proleptic Gregorian `year/month/day`.
+  constexpr std::int64_t days_from_civil(std::int64_t year, const unsigned month, const unsigned day) noexcept
+  {
+    year -= month <= 2;
+    const std::int64_t era = (0 <= year ? year : year - 399) / 400;
+    const unsigned yoe = unsigned(year - era * 400);
+    const unsigned doy = (153 * (2 < month ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + std::int64_t(doe) - 719468;
+  }
+
+  //! \return Unix timestamp for `YYYY-MM-DD` at 00:00 UTC, or `std::nullopt`.
+  inline std::optional<std::uint64_t> from_date(const std::string_view date) noexcept
+  {
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-')
+      return std::nullopt;
+
+    const auto year = from_string(date.substr(0, 4));
+    const auto month = from_string(date.substr(5, 2));
+    const auto day = from_string(date.substr(8, 2));
+    if (!year || !month || !day || *year < 1970 || *month < 1 || 12 < *month || *day < 1)
+      return std::nullopt;
+
+    constexpr const std::array<unsigned, 12> month_days{{31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
+    const bool leap = (*year % 4 == 0 && *year % 100 != 0) || *year % 400 == 0;
+    if (month_days[*month - 1] < *day || (*month == 2 && !leap && *day == 29))
+      return std::nullopt;
+
+    return std::uint64_t(days_from_civil(*year, unsigned(*month), unsigned(*day))) * 86400;
+  }
+
+  static_assert(days_from_civil(1970, 1, 1) == 0);
+  static_assert(height(Monero::MAINNET, 0) == 0);
+  static_assert(height(Monero::MAINNET, 1458748658) == 1009827 - safety_margin);
+}} // lwcli // restore
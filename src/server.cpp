@@ -0,0 +1,733 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "server.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <lws_frontend.h>
+#include <map>
+#include <mutex>
+#include <pthread.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "headless.h"
+#include "lwcli_config.h"
+#include "util.h"
+#include "wallet_open.h"
+
+namespace lwcli { namespace server
+{
+  namespace
+  {
+    using json_writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    //! Max bytes for one request line
+    constexpr const std::size_t max_request = 1024 * 1024;
+
+    enum error_code : int
+    {
+      parse_error = -32700,
+      invalid_request = -32600,
+      method_not_found = -32601,
+      invalid_params = -32602,
+      wallet_error = -32000
+    };
+
+    struct rpc_error final : public std::runtime_error
+    {
+      const int code;
+
+      rpc_error(const int code, const std::string& message)
+        : std::runtime_error(message), code(code)
+      {}
+    };
+
+    void string(json_writer& out, const std::string& value)
+    {
+      out.String(value.data(), value.size());
+    }
+
+    const rapidjson::Value* find(const rapidjson::Value& params, const char* name)
+    {
+      if (!params.IsObject())
+        return nullptr;
+      const auto member = params.FindMember(name);
+      if (member == params.MemberEnd())
+        return nullptr;
+      return std::addressof(member->value);
+    }
+
+    std::string get_string(const rapidjson::Value& params, const char* name)
+    {
+      const rapidjson::Value* const value = find(params, name);
+      if (!value || !value->IsString())
+        throw rpc_error{invalid_params, std::string{"Expected string "} + name};
+      return {value->GetString(), value->GetStringLength()};
+    }
+
+    std::uint64_t get_uint64(const rapidjson::Value& params, const char* name)
+    {
+      const rapidjson::Value* const value = find(params, name);
+      if (!value || !value->IsUint64())
+        throw rpc_error{invalid_params, std::string{"Expected unsigned integer "} + name};
+      return value->GetUint64();
+    }
+
+    std::uint32_t get_uint32(const rapidjson::Value& params, const char* name, const std::uint32_t fallback)
+    {
+      const rapidjson::Value* const value = find(params, name);
+      if (!value)
+        return fallback;
+      if (!value->IsUint())
+        throw rpc_error{invalid_params, std::string{"Expected unsigned integer "} + name};
+      return value->GetUint();
+    }
+
+    struct wallet_entry
+    {
+      std::mutex sync;
+      std::shared_ptr<Monero::Wallet> wal;
+
+      //! Call with `sync` held. \throw rpc_error if closed since `wallets::get`.
+      Monero::Wallet& checked() const
+      {
+        if (!wal)
+          throw rpc_error{wallet_error, "Wallet not open"};
+        return *wal;
+      }
+    };
+
+    class wallets
+    {
+      const std::shared_ptr<Monero::WalletManager> wm_;
+      std::mutex wm_sync_;
+      std::mutex sync_;
+      std::map<std::string, std::shared_ptr<wallet_entry>> open_;
+
+    public:
+      explicit wallets(std::shared_ptr<Monero::WalletManager> wm)
+        : wm_(std::move(wm)), wm_sync_(), sync_(), open_()
+      {
+        if (!wm_)
+          throw std::invalid_argument{"lwcli::server given nullptr"};
+      }
+
+      void open(const std::string& file, std::string password)
+      {
+        // `nullptr` reserves `file`, so concurrent opens of it fail here
+        {
+          const std::lock_guard<std::mutex> lock{sync_};
+          if (!open_.try_emplace(file, nullptr).second)
+            throw rpc_error{wallet_error, "Wallet already open"};
+        }
+
+        std::shared_ptr<wallet_entry> entry;
+        try
+        {
+          std::string error;
+          entry = std::make_shared<wallet_entry>();
+          {
+            const std::lock_guard<std::mutex> lock{wm_sync_};
+            entry->wal = prep_wallet(wm_, wm_->openWallet(file, password, config::network), &error);
+          }
+          password.clear();
+          if (!entry->wal || !init_wallet(*entry->wal, &error))
+            throw rpc_error{wallet_error, error};
+          if (!config::offline)
+            entry->wal->startRefresh();
+        }
+        catch (...)
+        {
+          const std::lock_guard<std::mutex> lock{sync_};
+          open_.erase(file);
+          throw;
+        }
+
+        const std::lock_guard<std::mutex> lock{sync_};
+        open_[file] = std::move(entry);
+      }
+
+      void close(const std::string& file)
+      {
+        std::shared_ptr<wallet_entry> entry;
+        {
+          const std::lock_guard<std::mutex> lock{sync_};
+          const auto match = open_.find(file);
+          if (match == open_.end() || !match->second)
+            throw rpc_error{wallet_error, "Wallet not open"};
+          entry = std::move(match->second);
+          open_.erase(match);
+        }
+
+        // wait for in-progress calls, last reference closes
+        const std::lock_guard<std::mutex> lock{entry->sync};
+        entry->wal.reset();
+      }
+
+      //! \return Wallet named by "wallet" in `params`, or the only open wallet.
+      std::shared_ptr<wallet_entry> get(const rapidjson::Value& params)
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (!find(params, "wallet"))
+        {
+          if (open_.size() != 1)
+            throw rpc_error{invalid_params, "Expected string wallet"};
+          if (!open_.begin()->second)
+            throw rpc_error{wallet_error, "Wallet not open"};
+          return open_.begin()->second;
+        }
+
+        const auto match = open_.find(get_string(params, "wallet"));
+        if (match == open_.end() || !match->second)
+          throw rpc_error{wallet_error, "Wallet not open"};
+        return match->second;
+      }
+
+      void list(json_writer& out)
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        out.StartArray();
+        for (const auto& entry : open_)
+        {
+          if (entry.second)
+            string(out, entry.first);
+        }
+        out.EndArray();
+      }
+    };
+
+    using method = void(wallets&, const rapidjson::Value&, json_writer&);
+
+    void open_wallet(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      const std::string file = get_string(params, "file");
+      all.open(file, get_string(params, "password"));
+      out.StartObject();
+      out.Key("wallet");
+      string(out, file);
+      out.EndObject();
+    }
+
+    void close_wallet(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      all.close(get_string(params, "wallet"));
+      out.Bool(true);
+    }
+
+    void list_wallets(wallets& all, const rapidjson::Value&, json_writer& out)
+    {
+      all.list(out);
+    }
+
+    void get_balance(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      const std::uint32_t account = get_uint32(params, "account", 0);
+      const auto entry = all.get(params);
+      const std::lock_guard<std::mutex> lock{entry->sync};
+      Monero::Wallet& wal = entry->checked();
+
+      out.StartObject();
+      out.Key("balance");
+      out.Uint64(wal.balance(account));
+      out.Key("unlocked_balance");
+      out.Uint64(wal.unlockedBalance(account));
+      out.Key("height");
+      out.Uint64(wal.blockChainHeight());
+      out.Key("synchronized");
+      out.Bool(wal.synchronized());
+      out.EndObject();
+    }
+
+    void get_address(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      const std::uint32_t account = get_uint32(params, "account", 0);
+      const std::uint32_t minor = get_uint32(params, "minor", 0);
+      const auto entry = all.get(params);
+      const std::lock_guard<std::mutex> lock{entry->sync};
+      Monero::Wallet& wal = entry->checked();
+
+      out.StartObject();
+      out.Key("address");
+      string(out, wal.address(account, minor));
+      out.EndObject();
+    }
+
+    void create_address(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      const std::uint32_t account = get_uint32(params, "account", 0);
+      const std::string label = find(params, "label") ? get_string(params, "label") : std::string{};
+      const auto entry = all.get(params);
+      const std::lock_guard<std::mutex> lock{entry->sync};
+      Monero::Wallet& wal = entry->checked();
+
+      wal.addSubaddress(account, label);
+      const std::size_t count = wal.numSubaddresses(account);
+      if (!count)
+        throw rpc_error{wallet_error, wal.errorString()};
+      const std::uint32_t minor = std::uint32_t(count - 1);
+
+      out.StartObject();
+      out.Key("minor");
+      out.Uint(minor);
+      out.Key("address");
+      string(out, wal.address(account, minor));
+      out.EndObject();
+    }
+
+    void transfer(wallets& all, const rapidjson::Value& params, json_writer& out)
+    {
+      if (config::offline)
+        throw rpc_error{wallet_error, "transfer is not available with --offline"};
+
+      const std::uint32_t account = get_uint32(params, "account", 0);
+      const std::uint32_t priority = get_uint32(params, "priority", Monero::PendingTransaction::Priority_Default);
+      if (Monero::PendingTransaction::Priority_Last <= priority)
+        throw rpc_error{invalid_params, "Invalid priority"};
+
+      const rapidjson::Value* const dests = find(params, "destinations");
+      if (!dests || !dests->IsArray() || dests->Empty())
+        throw rpc_error{invalid_params, "Expected array destinations"};
+
+      const auto entry = all.get(params);
+      const std::lock_guard<std::mutex> lock{entry->sync};
+      Monero::Wallet& wal = entry->checked();
+
+      std::vector<std::string> addresses;
+      std::vector<std::uint64_t> amounts;
+      addresses.reserve(dests->Size());
+      amounts.reserve(dests->Size());
+      for (const rapidjson::Value& dest : dests->GetArray())
+      {
+        addresses.push_back(get_string(dest, "address"));
+        amounts.push_back(get_uint64(dest, "amount"));
+        if (!lwsf::addressValid(addresses.back(), wal.nettype()))
+          throw rpc_error{invalid_params, "Invalid address " + addresses.back()};
+        if (!amounts.back())
+          throw rpc_error{invalid_params, "Invalid amount"};
+      }
+
+      const auto dispose = [&wal] (Monero::PendingTransaction* ptr)
+      {
+        if (ptr)
+          wal.disposeTransaction(ptr);
+      };
+      const std::unique_ptr<Monero::PendingTransaction, decltype(dispose)> tx{
+        wal.createTransactionMultDest(addresses, {}, std::move(amounts), 0 /*mixin_count*/, Monero::PendingTransaction::Priority(priority), account),
+        dispose
+      };
+      if (!tx)
+        throw std::runtime_error{"Unexpected nullptr tx"};
+      if (tx->status() != Monero::PendingTransaction::Status_Ok || !tx->commit())
+        throw rpc_error{wallet_error, tx->errorString()};
+
+      out.StartObject();
+      out.Key("amount");
+      out.Uint64(tx->amount());
+      out.Key("fee");
+      out.Uint64(tx->fee());
+      out.Key("txids");
+      out.StartArray();
+      for (const std::string& id : tx->txid())
+        string(out, id);
+      out.EndArray();
+      out.EndObject();
+    }
+
+    constexpr const std::array<std::pair<std::string_view, method*>, 7> methods{{
+      {"close_wallet", close_wallet},
+      {"create_address", create_address},
+      {"get_address", get_address},
+      {"get_balance", get_balance},
+      {"list_wallets", list_wallets},
+      {"open_wallet", open_wallet},
+      {"transfer", transfer}
+    }};
+
+    //! Per-connection buffers, reused across requests
+    struct session
+    {
+      rapidjson::StringBuffer response;
+      rapidjson::StringBuffer result;
+      json_writer out;
+      json_writer result_out;
+
+      session()
+        : response(), result(), out(response), result_out(result)
+      {}
+    };
+
+    void write_error(json_writer& out, const rapidjson::Value* id, const int code, const char* message)
+    {
+      out.StartObject();
+      out.Key("jsonrpc");
+      out.String("2.0");
+      out.Key("id");
+      if (id)
+        id->Accept(out);
+      else
+        out.Null();
+      out.Key("error");
+      out.StartObject();
+      out.Key("code");
+      out.Int(code);
+      out.Key("message");
+      out.String(message);
+      out.EndObject();
+      out.EndObject();
+    }
+
+    //! \return False if `request` was a notification (no response written).
+    bool handle(wallets& all, session& state, const rapidjson::Value& request)
+    {
+      if (!request.IsObject())
+      {
+        write_error(state.out, nullptr, invalid_request, "Invalid Request");
+        return true;
+      }
+
+      const rapidjson::Value* const id = find(request, "id");
+      const rapidjson::Value* const name = find(request, "method");
+      if (!name || !name->IsString())
+      {
+        write_error(state.out, id, invalid_request, "Invalid Request");
+        return true;
+      }
+
+      const std::string_view method_name{name->GetString(), name->GetStringLength()};
+      const auto match = std::find_if(methods.begin(), methods.end(), [method_name] (const auto& e) {
+        return e.first == method_name;
+      });
+
+      static const rapidjson::Value empty{rapidjson::kObjectType};
+      const rapidjson::Value* params = find(request, "params");
+      if (!params)
+        params = std::addressof(empty);
+
+      // result is built separately so that errors never leave partial output
+      state.result.Clear();
+      state.result_out.Reset(state.result);
+      try
+      {
+        if (match == methods.end())
+          throw rpc_error{method_not_found, "Method not found"};
+        match->second(all, *params, state.result_out);
+      }
+      catch (const rpc_error& e)
+      {
+        if (id)
+          write_error(state.out, id, e.code, e.what());
+        return bool(id);
+      }
+      catch (const std::exception& e)
+      {
+        if (id)
+          write_error(state.out, id, wallet_error, e.what());
+        return bool(id);
+      }
+
+      if (!id)
+        return false;
+
+      state.out.StartObject();
+      state.out.Key("jsonrpc");
+      state.out.String("2.0");
+      state.out.Key("id");
+      id->Accept(state.out);
+      state.out.Key("result");
+      state.out.RawValue(state.result.GetString(), state.result.GetSize(), rapidjson::kObjectType);
+      state.out.EndObject();
+      return true;
+    }
+
+    //! \return False if nothing should be sent back.
+    bool handle_line(wallets& all, session& state, char* line)
+    {
+      state.response.Clear();
+      state.out.Reset(state.response);
+
+      rapidjson::Document doc;
+      if (doc.ParseInsitu(line).HasParseError())
+      {
+        write_error(state.out, nullptr, parse_error, "Parse error");
+        return true;
+      }
+
+      if (!doc.IsArray())
+        return handle(all, state, doc);
+
+      if (doc.Empty())
+      {
+        write_error(state.out, nullptr, invalid_request, "Invalid Request");
+        return true;
+      }
+
+      bool any = false;
+      state.out.StartArray();
+      for (const rapidjson::Value& request : doc.GetArray())
+        any |= handle(all, state, request);
+      state.out.EndArray();
+      return any;
+    }
+
+    bool send_all(const int fd, const char* data, std::size_t length)
+    {
+      while (length)
+      {
+        const ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return false;
+        }
+        data += sent;
+        length -= std::size_t(sent);
+      }
+      return true;
+    }
+
+    void serve_client(wallets& all, const int fd)
+    {
+      session state{};
+      std::string buffer;
+      char chunk[4096];
+      for (;;)
+      {
+        const ssize_t read = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (read < 0 && errno == EINTR)
+          continue;
+        if (read <= 0)
+          return;
+
+        buffer.append(chunk, std::size_t(read));
+        std::size_t start = 0;
+        for (std::size_t end = buffer.find('\n'); end != std::string::npos; end = buffer.find('\n', start))
+        {
+          buffer[end] = 0; // insitu parsing needs null terminated input
+          if (start != end && handle_line(all, state, std::addressof(buffer[start])))
+          {
+            if (!send_all(fd, state.response.GetString(), state.response.GetSize()) || !send_all(fd, "\n", 1))
+              return;
+          }
+          start = end + 1;
+        }
+        buffer.erase(0, start);
+        if (max_request < buffer.size())
+          return;
+      }
+    }
+
+    struct client
+    {
+      const int fd;
+      std::atomic<bool> done;
+      std::thread thread;
+
+      explicit client(const int fd)
+        : fd(fd), done(false), thread()
+      {}
+    };
+
+    //! Stops and joins every client thread on destruction
+    struct client_list
+    {
+      std::list<client> clients;
+
+      client_list()
+        : clients()
+      {}
+
+      ~client_list() noexcept
+      {
+        for (client& c : clients)
+        {
+          ::shutdown(c.fd, SHUT_RDWR);
+          if (c.thread.joinable())
+            c.thread.join();
+          ::close(c.fd);
+        }
+      }
+
+      void reap()
+      {
+        clients.remove_if([] (client& c) {
+          if (!c.done)
+            return false;
+          c.thread.join();
+          ::close(c.fd);
+          return true;
+        });
+      }
+    };
+
+    struct socket_fd
+    {
+      int fd;
+
+      ~socket_fd() noexcept
+      {
+        if (0 <= fd)
+          ::close(fd);
+      }
+    };
+
+    int listen_unix(const std::string& path)
+    {
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      if (sizeof(address.sun_path) <= path.size())
+        throw std::runtime_error{"socket path too long"};
+      std::memcpy(address.sun_path, path.data(), path.size());
+
+      const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+        throw std::runtime_error{std::string{"socket: "} + std::strerror(errno)};
+
+      if (!unlink_socket(path))
+      {
+        ::close(fd);
+        throw std::runtime_error{path + ": path exists and is not a socket"};
+      }
+      // owner only, the socket opens wallets and sends funds
+      const mode_t mask = ::umask(077);
+      const int bound = ::bind(fd, reinterpret_cast<const sockaddr*>(std::addressof(address)), sizeof(address));
+      const int bind_error = errno;
+      ::umask(mask);
+      if (bound != 0 || ::listen(fd, SOMAXCONN) != 0)
+      {
+        const int error = bound != 0 ? bind_error : errno;
+        ::close(fd);
+        throw std::runtime_error{"bind/listen " + path + ": " + std::strerror(error)};
+      }
+      return fd;
+    }
+
+    //! Waits for SIGINT/SIGTERM on its own thread, then wakes `accept`
+    class signal_watch
+    {
+      sigset_t set_;
+      std::atomic<bool> stop_;
+      std::thread thread_;
+
+    public:
+      signal_watch(const sigset_t& set, const int listener)
+        : set_(set), stop_(false), thread_()
+      {
+        thread_ = std::thread{[this, listener] () {
+          int signal = 0;
+          sigwait(std::addressof(set_), std::addressof(signal));
+          stop_ = true;
+          ::shutdown(listener, SHUT_RDWR);
+        }};
+      }
+
+      ~signal_watch() noexcept
+      {
+        // wake `sigwait` if the loop ended some other way
+        pthread_kill(thread_.native_handle(), SIGTERM);
+        thread_.join();
+      }
+
+      bool stopping() const noexcept { return stop_; }
+    };
+  } // anonymous
+
+  int run(std::shared_ptr<Monero::WalletManager> wm, const std::string& path, const std::string& file)
+  {
+    // handle SIGINT/SIGTERM on a dedicated thread, all others inherit the mask
+    sigset_t signals{};
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+      wallets all{std::move(wm)};
+      if (!file.empty())
+        all.open(file, headless::read_password());
+
+      const socket_fd listener{listen_unix(path)};
+      const signal_watch watch{signals, listener.fd};
+
+      // destroyed before `all`, so no client outlives the wallets
+      client_list active{};
+      std::fprintf(stderr, "Listening on %s\n", path.c_str());
+      for (;;)
+      {
+        const int fd = ::accept4(listener.fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+          if (watch.stopping())
+            break;
+          if (errno != EINTR && errno != ECONNABORTED)
+          {
+            // likely fd or memory exhaustion, retry once clients finish
+            std::fprintf(stderr, "accept: %s\n", std::strerror(errno));
+            active.reap();
+            std::this_thread::sleep_for(std::chrono::milliseconds{100});
+          }
+          continue;
+        }
+
+        active.reap();
+        client& added = active.clients.emplace_back(fd);
+        added.thread = std::thread{[&all, &added] () {
+          serve_client(all, added.fd);
+          added.done = true;
+        }};
+      }
+    }
+    catch (const std::exception& e)
+    {
+      std::fprintf(stderr, "Fatal Error: %s\n", e.what());
+      return EXIT_FAILURE;
+    }
+
+    unlink_socket(path);
+    return EXIT_SUCCESS;
+  }
+}} // lwcli // server
@@ -0,0 +1,220 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "timer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <ftxui/component/screen_interactive.hpp>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "events.h"
+
+namespace lwcli { namespace timer
+{
+  namespace
+  {
+    //! One thread sleeping until the earliest deadline, or indefinitely when empty
+    class queue
+    {
+      using key = std::pair<clock::time_point, id>;
+
+      std::mutex sync_;
+      std::condition_variable notify_;
+      std::map<key, std::function<clock::time_point()>> pending_;
+      std::thread thread_;
+      std::atomic<std::uint64_t> wakeups_;
+      id next_;
+      id running_;
+      bool cancelled_;
+      bool animating_;
+      bool stop_;
+
+      void run()
+      {
+        std::unique_lock lock{sync_};
+        while (!stop_)
+        {
+          if (pending_.empty())
+            notify_.wait(lock);
+          else if (clock::now() < pending_.begin()->first.first)
+            notify_.wait_until(lock, pending_.begin()->first.first);
+          else
+          {
+            auto next = pending_.begin();
+            const id handle = next->first.second;
+            std::function<clock::time_point()> fn = std::move(next->second);
+            pending_.erase(next);
+
+            running_ = handle;
+            cancelled_ = false;
+            lock.unlock();
+
+            clock::time_point when = done;
+            try { when = fn(); }
+            catch (...) {} // timer thread has no one to report to
+
+            lock.lock();
+            if (when != done && !cancelled_ && !stop_)
+              pending_.emplace(key{when, handle}, std::move(fn));
+            running_ = 0;
+            notify_.notify_all(); // `cancel` may be waiting
+            continue;
+          }
+          wakeups_.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+    public:
+      queue()
+        : sync_(),
+          notify_(),
+          pending_(),
+          thread_(),
+          wakeups_(0),
+          next_(1),
+          running_(0),
+          cancelled_(false),
+          animating_(false),
+          stop_(false)
+      {}
+
+      ~queue() noexcept
+      {
+        {
+          const std::lock_guard<std::mutex> lock{sync_};
+          stop_ = true;
+          notify_.notify_all();
+        }
+        if (thread_.joinable())
+          thread_.join();
+      }
+
+      id schedule(const clock::time_point when, std::function<clock::time_point()> fn)
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        if (!thread_.joinable())
+          thread_ = std::thread{[this] () { run(); }};
+
+        const id handle = next_++;
+        pending_.emplace(key{when, handle}, std::move(fn));
+        notify_.notify_all();
+        return handle;
+      }
+
+      void cancel(const id handle) noexcept
+      {
+        std::unique_lock lock{sync_};
+        for (auto it = pending_.begin(); it != pending_.end(); ++it)
+        {
+          if (it->first.second == handle)
+          {
+            pending_.erase(it);
+            break;
+          }
+        }
+
+        if (running_ == handle)
+        {
+          cancelled_ = true;
+          notify_.wait(lock, [this, handle] () { return running_ != handle; });
+        }
+      }
+
+      //! \return True if the caller should schedule the animation tick
+      bool start_animation()
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        return !std::exchange(animating_, true);
+      }
+
+      void stop_animation()
+      {
+        const std::lock_guard<std::mutex> lock{sync_};
+        animating_ = false;
+      }
+
+      std::uint64_t wakeups() const noexcept
+      {
+        return wakeups_.load(std::memory_order_relaxed);
+      }
+    };
+
+    std::atomic<std::uint64_t> redraw_count{0};
+
+    queue& get_queue()
+    {
+      static queue instance{};
+      return instance;
+    }
+  } // anonymous
+
+  id schedule(const clock::time_point when, std::function<clock::time_point()> fn)
+  {
+    return get_queue().schedule(when, std::move(fn));
+  }
+
+  void cancel(const id handle) noexcept
+  {
+    get_queue().cancel(handle);
+  }
+
+  void redraw()
+  {
+    redraw_count.fetch_add(1, std::memory_order_relaxed);
+    ftxui::ScreenInteractive* const active = ftxui::ScreenInteractive::Active();
+    if (active)
+      active->PostEvent(event::redraw);
+  }
+
+  void animate(const clock::duration delay)
+  {
+    queue& self = get_queue();
+    if (!self.start_animation())
+      return;
+
+    self.schedule(clock::now() + delay, [] () {
+      get_queue().stop_animation();
+      redraw();
+      return done;
+    });
+  }
+
+  std::uint64_t wakeups() noexcept
+  {
+    return get_queue().wakeups();
+  }
+
+  std::uint64_t redraws() noexcept
+  {
+    return redraw_count.load(std::memory_order_relaxed);
+  }
+}} // lwcli // timer
@@ -0,0 +1,118 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace lwcli { namespace timer
+{
+  using clock = std::chrono::steady_clock;
+  using id = std::uint64_t;
+
+  //! Returned by a callback that should not run again.
+  constexpr const clock::time_point done = clock::time_point::max();
+
+  /*! Runs `fn` on the shared timer thread at or after `when`. The callback
+    returns its next deadline, or `done`. \return Handle for `cancel`, never 0. */
+  id schedule(clock::time_point when, std::function<clock::time_point()> fn);
+
+  /*! Removes `handle` from the queue, and waits if its callback is running.
+    Must not be called from inside that callback. */
+  void cancel(id handle) noexcept;
+
+  //! Posts `event::redraw` to the active screen. Callable from any thread.
+  void redraw();
+
+  /*! Posts `event::redraw` once `delay` elapses. Calls made before then share
+    the one wakeup, so calling from `OnRender` animates only while visible. */
+  void animate(clock::duration delay);
+
+  //! \return Times the timer thread has woken up, for `lwcli-bench idle`.
+  std::uint64_t wakeups() noexcept;
+
+  //! \return Calls to `redraw`, with or without a screen, for `lwcli-bench idle`.
+  std::uint64_t redraws() noexcept;
+
+  //! Result of `async_redraw`. Destruction waits for the task, like `std::async`.
+  template<typename R>
+  class background
+  {
+    std::future<R> result_;
+    std::future<void> task_;
+
+  public:
+    background() = default;
+    background(std::future<R> result, std::future<void> task) noexcept
+      : result_(std::move(result)), task_(std::move(task))
+    {}
+
+    bool valid() const noexcept { return result_.valid(); }
+
+    //! \return True if `get()` will not block.
+    bool ready() const
+    { return result_.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+
+    R get() { return result_.get(); }
+  };
+
+  /*! Runs `f(args...)` on a new thread, then posts `event::redraw`. The
+    result is ready before the redraw, so `OnRender` can check it without
+    polling. */
+  template<typename F, typename... T>
+  auto async_redraw(F f, T&&... args)
+  {
+    using result = std::invoke_result_t<F, std::decay_t<T>...>;
+
+    std::promise<result> promise;
+    std::future<result> out = promise.get_future();
+    std::future<void> task = std::async(
+      std::launch::async,
+      [f, promise = std::move(promise)] (std::decay_t<T>... values) mutable
+      {
+        try
+        {
+          promise.set_value(f(std::move(values)...));
+        }
+        catch (...)
+        {
+          promise.set_exception(std::current_exception());
+        }
+        redraw();
+      },
+      std::forward<T>(args)...
+    );
+    return background<result>{std::move(out), std::move(task)};
+  }
+}} // lwcli // timer
@@ -0,0 +1,170 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lwcli { namespace trace
+{
+  namespace
+  {
+    struct event
+    {
+      const char* name;
+      std::int64_t start;
+      std::int64_t duration;
+    };
+
+    //! Spans from one thread; only contended when `stop()` runs.
+    struct thread_buffer
+    {
+      std::mutex sync;
+      std::vector<event> events;
+      std::uint32_t id;
+    };
+
+    struct state
+    {
+      std::mutex sync;
+      std::vector<std::shared_ptr<thread_buffer>> threads;
+      std::FILE* file = nullptr;
+      std::uint32_t next_id = 1;
+    };
+
+    std::atomic<bool> enabled{false};
+
+    state& get_state()
+    {
+      static state instance{};
+      return instance;
+    }
+
+    std::int64_t now() noexcept
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count();
+    }
+
+    thread_buffer& get_buffer()
+    {
+      thread_local const std::shared_ptr<thread_buffer> buffer = [] ()
+      {
+        auto out = std::make_shared<thread_buffer>();
+        state& global = get_state();
+        const std::lock_guard<std::mutex> lock{global.sync};
+        out->id = global.next_id++;
+        global.threads.push_back(out);
+        return out;
+      }();
+      return *buffer;
+    }
+
+    void write_name(std::FILE* file, const char* name)
+    {
+      for (; *name; ++name)
+      {
+        if (*name == '"' || *name == '\\')
+          std::fputc('\\', file);
+        std::fputc(*name, file);
+      }
+    }
+  } // anonymous
+
+  bool start(const std::string& file)
+  {
+    state& global = get_state();
+    const std::lock_guard<std::mutex> lock{global.sync};
+    if (global.file)
+      return false;
+
+    global.file = std::fopen(file.c_str(), "w");
+    if (!global.file)
+      return false;
+
+    enabled = true;
+    return true;
+  }
+
+  void stop()
+  {
+    enabled = false;
+
+    state& global = get_state();
+    const std::lock_guard<std::mutex> lock{global.sync};
+    if (!global.file)
+      return;
+
+    bool first = true;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", global.file);
+    for (const auto& thread : global.threads)
+    {
+      const std::lock_guard<std::mutex> thread_lock{thread->sync};
+      for (const event& e : thread->events)
+      {
+        std::fputs(first ? "\n{\"name\":\"" : ",\n{\"name\":\"", global.file);
+        write_name(global.file, e.name);
+        std::fprintf(
+          global.file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+          unsigned(thread->id), e.start / 1000.0, e.duration / 1000.0
+        );
+        first = false;
+      }
+      thread->events.clear();
+    }
+    std::fputs("\n]}\n", global.file);
+    std::fclose(global.file);
+    global.file = nullptr;
+  }
+
+  span::span(const char* name) noexcept
+    : marker_(name), name_(name), start_(enabled.load(std::memory_order_relaxed) ? now() : -1)
+  {}
+
+  span::~span() noexcept
+  {
+    if (start_ < 0 || !enabled.load(std::memory_order_relaxed))
+      return;
+
+    const std::int64_t end = now();
+    try
+    {
+      thread_buffer& buffer = get_buffer();
+      const std::lock_guard<std::mutex> lock{buffer.sync};
+      buffer.events.push_back({name_, start_, end - start_});
+    }
+    catch (...)
+    {} // drop the span rather than take down the UI
+  }
+}} // lwcli // trace
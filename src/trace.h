@@ -0,0 +1,98 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace lwcli { namespace trace
+{
+  /*! Begin recording spans, which are written to `file` as Chrome
+    `trace_event` JSON by `stop()`. \return False if `file` cannot be opened. */
+  bool start(const std::string& file);
+
+  //! Write recorded spans and stop recording. No-op if `start` was not called.
+  void stop();
+
+  //! Set on the thread running the UI loop; only its markers are published.
+  inline thread_local bool ui_thread = false;
+
+  //! Innermost marked scope on the UI thread, or `nullptr`. Readable from any thread.
+  inline std::atomic<const char*> ui_operation{nullptr};
+
+  //! Publishes `name` as `ui_operation` for the lifetime of a scope. Always compiled in.
+  class marker
+  {
+    const char* const previous_;
+
+  public:
+    explicit marker(const char* name) noexcept
+      : previous_(ui_thread ? ui_operation.exchange(name, std::memory_order_relaxed) : nullptr)
+    {}
+
+    ~marker() noexcept
+    {
+      if (ui_thread)
+        ui_operation.store(previous_, std::memory_order_relaxed);
+    }
+
+    marker(const marker&) = delete;
+    marker& operator=(const marker&) = delete;
+  };
+
+  //! Records the lifetime of a scope. `name` must have static storage duration.
+  class span
+  {
+    const marker marker_;
+    const char* const name_;
+    const std::int64_t start_;
+
+  public:
+    explicit span(const char* name) noexcept;
+    ~span() noexcept;
+
+    span(const span&) = delete;
+    span& operator=(const span&) = delete;
+  };
+}} // lwcli // trace
+
+#define LWCLI_TRACE_CONCAT_(x, y) x ## y
+#define LWCLI_TRACE_CONCAT(x, y) LWCLI_TRACE_CONCAT_(x, y)
+
+/* Without LWCLI_TRACE_ENABLED only the `marker` remains, so the stall
+  watchdog can still name the operation blocking the UI thread. */
+#ifdef LWCLI_TRACE_ENABLED
+  #define LWCLI_TRACE(name) const ::lwcli::trace::span LWCLI_TRACE_CONCAT(lwcli_trace_, __LINE__){name}
+#else
+  #define LWCLI_TRACE(name) const ::lwcli::trace::marker LWCLI_TRACE_CONCAT(lwcli_trace_, __LINE__){name}
+#endif
+
+//! Evaluates `expr` inside a span, for calls in the middle of an expression.
+#define LWCLI_TRACE_CALL(name, expr) ([&] () -> decltype(auto) { LWCLI_TRACE(name); return expr; }())
@@ -31,7 +31,10 @@
 #include <charconv>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
 
 
 namespace lwcli
@@ -45,4 +48,17 @@ namespace lwcli
       return std::nullopt;
     return height;
   }
+
+  /*! Removes a stale unix socket at `path`; anything else is left alone.
+    \return False if `path` exists and is not a socket. */
+  inline bool unlink_socket(const std::string& path) noexcept
+  {
+    struct stat info{};
+    if (::lstat(path.c_str(), &info) != 0)
+      return true; // nothing to remove
+    if (!S_ISSOCK(info.st_mode))
+      return false;
+    ::unlink(path.c_str());
+    return true;
+  }
 }
@@ -36,8 +36,10 @@
 
 #include "components/table.h"
 #include "decorate/overlay.h"
+#include "decorate/qrcode.h"
 #include "events.h"
 #include "lwcli_config.h"
+#include "trace.h"
 #include "translate.h"
 #include "util.h"
 
@@ -55,37 +57,6 @@ namespace lwcli { namespace view
 
     ftxui::ButtonOption ascii() { return ftxui::ButtonOption::Ascii(); }
 
-    ftxui::Canvas make_qr_code(std::vector<std::vector<std::uint8_t>> raw)
-    {
-      const std::size_t size = raw.size();
-      if (std::numeric_limits<std::size_t>::max() / 4 < size)
-        throw std::runtime_error{"qrcode too large"};
-      if (std::numeric_limits<int>::max() / 4 < size)
-        throw std::runtime_error{"qrcode too large"};
-
-      const std::size_t canvas_size = (size * 2) + ((size % 2) * 2);
-      ftxui::Canvas out{int(canvas_size), int(canvas_size)};
-      for (std::size_t y = 0; y < canvas_size; ++y)
-        for (std::size_t x = 0; x < canvas_size; ++x)
-          out.DrawBlockOff(x, y);
-
-      for (std::size_t y = 0; y < size; ++y)
-      {
-        const auto& row = raw.at(y);
-        for (std::size_t x = 0; x < size; ++x)
-        {
-          if (row.at(x))
-          {
-            const int real_x = x * 2;
-            const int real_y = y * 2;
-            out.DrawBlockOn(real_x, real_y);
-            out.DrawBlockOn(real_x + 1, real_y);
-          }
-        }
-      }
-      return out;
-    }
-
     class subaccount_ final : public ftxui::ComponentBase
     {
       std::string subaccount_name_;
@@ -110,7 +81,7 @@ namespace lwcli { namespace view
           wal_(std::move(wal)),
           title_(ftxui::text(wal_->address(major, minor))),
           desc_(ftxui::text(_("Name: "))),
-          qr_code_raw_(make_qr_code(lwsf::qrcode(wal_.get(), major, minor))),
+          qr_code_raw_(decorate::make_qr_code(lwsf::qrcode(wal_.get(), major, minor))),
           qr_code_(ftxui::canvas(&qr_code_raw_)),
           buttons_(),
           name_(last_input(&subaccount_name_)),
@@ -140,11 +111,11 @@ namespace lwcli { namespace view
 
       ftxui::Element OnRender() override final
       {
-        return ftxui::window(title_, ftxui::vbox({
+        return decorate::window(title_, ftxui::vbox({
           buttons_->Render() | ftxui::hcenter,
-          ftxui::separator(),
+          decorate::separator(),
           ftxui::hbox({desc_, name_->Render()}),
-          ftxui::separator(),
+          decorate::separator(),
           qr_code_ | ftxui::hcenter
         }));
       }
@@ -209,7 +180,7 @@ namespace lwcli { namespace view
             wal_->setSubaddressLabel(id_, 0, account_name_);
             throw event::close{};
           }, ascii()),
-          ftxui::Button(_("Add Subaddress"), [this] () { acct_->addRow(id_, std::string{}); }, ascii())
+          ftxui::Button(_("Add Subaddress"), [this] () { LWCLI_TRACE_CALL("Subaddress::addRow", acct_->addRow(id_, std::string{})); }, ascii())
         });
  
         table_ = component::table(
@@ -260,8 +231,8 @@ namespace lwcli { namespace view
       {
         std::vector<std::vector<std::string>> rows{};
 
-        acct_->refresh(id_);
-        auto all = acct_->getAll();
+        LWCLI_TRACE_CALL("Subaddress::refresh", acct_->refresh(id_));
+        auto all = LWCLI_TRACE_CALL("Subaddress::getAll", acct_->getAll());
 
         // reverse order sort
         std::sort(all.begin(), all.end(), [] (const auto x, const auto y) {
@@ -288,11 +259,11 @@ namespace lwcli { namespace view
       {
         if (!details_)
         {
-          cached_ = ftxui::window(title_, ftxui::vbox({
+          cached_ = decorate::window(title_, ftxui::vbox({
             buttons_->Render() | ftxui::hcenter,
-            ftxui::separator(),
+            decorate::separator(),
             ftxui::gridbox({address_, {desc_, name_->Render()}}), 
-            ftxui::separator(),
+            decorate::separator(),
             table_->Render() | ftxui::vscroll_indicator | ftxui::yframe | ftxui::center
           }));
           return cached_;
@@ -398,8 +369,8 @@ namespace lwcli { namespace view
       {
         std::vector<std::vector<std::string>> rows{};
 
-        wal_accounts_->refresh();
-        auto all = wal_accounts_->getAll();
+        LWCLI_TRACE_CALL("SubaddressAccount::refresh", wal_accounts_->refresh());
+        auto all = LWCLI_TRACE_CALL("SubaddressAccount::getAll", wal_accounts_->getAll());
 
         // reverse order sort
         std::sort(all.begin(), all.end(), [] (const auto x, const auto y) {
@@ -428,9 +399,9 @@ namespace lwcli { namespace view
       {
         if (!details_)
         {
-          table_cached_ = ftxui::window(title_, ftxui::vbox({
+          table_cached_ = decorate::window(title_, ftxui::vbox({
             buttons_->Render() | ftxui::hcenter,
-            ftxui::separator(),
+            decorate::separator(),
             table_->Render() | ftxui::vscroll_indicator | ftxui::yframe | ftxui::center,
             instructions_
           }));
@@ -0,0 +1,169 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "calls.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
+#include <ftxui/dom/elements.hpp>
+#include <iterator>
+
+#include "components/table.h"
+#include "decorate/overlay.h"
+#include "events.h"
+#include "proxy/instrument.h"
+#include "translate.h"
+
+namespace lwcli { namespace view
+{
+  namespace
+  {
+    ftxui::ButtonOption ascii() { return ftxui::ButtonOption::Ascii(); }
+
+    constexpr const char* bars[] = {" ", "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█"};
+
+    //! One character per latency bucket, scaled to the largest bucket
+    std::string histogram(const proxy::call_stats& stats)
+    {
+      const std::uint64_t max = *std::max_element(stats.histogram.begin(), stats.histogram.end());
+      std::string out;
+      out.reserve(stats.histogram.size() * 3);
+      for (const std::uint64_t count : stats.histogram)
+      {
+        std::size_t level = 0;
+        if (count && max)
+          level = 1 + ((count * (std::size(bars) - 2)) / max);
+        out.append(bars[level]);
+      }
+      return out;
+    }
+
+    std::string fixed(const double value)
+    {
+      char buf[32] = {0};
+      std::snprintf(buf, sizeof(buf), "%.1f", value);
+      return buf;
+    }
+
+    class calls_ final : public ftxui::ComponentBase
+    {
+      const std::shared_ptr<proxy::instrument> stats_;
+      std::string toggle_label_;
+      ftxui::Component buttons_;
+      ftxui::Component table_;
+      ftxui::Component ui_;
+
+      bool Focusable() const override final { return true; }
+      ftxui::Component ActiveChild() override final { return ui_; }
+
+      void update_label()
+      {
+        toggle_label_ = stats_->enabled() ? _("Pause") : _("Record");
+      }
+
+      std::vector<std::vector<std::string>> stats_list() const
+      {
+        const auto stats = stats_->snapshot();
+
+        std::vector<std::vector<std::string>> rows;
+        rows.reserve(stats.size());
+        for (const proxy::call_stats& entry : stats)
+        {
+          const double count = entry.count ? double(entry.count) : 1;
+          rows.push_back({
+            entry.name,
+            std::to_string(entry.count),
+            std::to_string(entry.ui_count),
+            std::to_string(entry.count - entry.ui_count),
+            std::to_string(entry.threads.size()),
+            fixed(entry.total_ns / count / 1000),
+            fixed(entry.max_ns / 1000.0),
+            fixed(entry.total_ns / 1000000.0),
+            histogram(entry)
+          });
+        }
+        return rows;
+      }
+
+    public:
+      explicit calls_(std::shared_ptr<proxy::instrument>&& stats)
+        : ftxui::ComponentBase(),
+          stats_(std::move(stats)),
+          toggle_label_(),
+          buttons_(),
+          table_(),
+          ui_()
+      {
+        update_label();
+        buttons_ = ftxui::Container::Horizontal({
+          ftxui::Button(_("Close"), [] () { throw event::close{}; }, ascii()),
+          ftxui::Button(&toggle_label_, [this] () {
+            stats_->enable(!stats_->enabled());
+            update_label();
+          }, ascii()),
+          ftxui::Button(_("Reset"), [this] () { stats_->reset(); }, ascii())
+        });
+
+        table_ = component::table(
+          {_("Call"), _("Count"), _("UI"), _("Other"), _("Threads"), _("Mean us"), _("Max us"), _("Total ms"), _("<1us .. >262ms")},
+          [this] () { return stats_list(); },
+          [] (ftxui::Event, std::size_t) { return false; }
+        );
+
+        ui_ = ftxui::Container::Vertical({buttons_, table_});
+        Add(ui_);
+      }
+
+      bool OnEvent(ftxui::Event event) override final
+      {
+        if (event == ftxui::Event::CtrlQ)
+          throw event::close{};
+        ui_->OnEvent(std::move(event));
+        return true;
+      }
+
+      ftxui::Element OnRender() override final
+      {
+        return decorate::window(ftxui::text(_("Wallet Calls")), ftxui::vbox({
+          buttons_->Render() | ftxui::hcenter,
+          decorate::separator(),
+          table_->Render() | ftxui::vscroll_indicator | ftxui::yframe
+        }));
+      }
+    };
+  } // anonymous
+
+  ftxui::Component calls(std::shared_ptr<proxy::instrument> stats)
+  {
+    if (!stats)
+      throw std::invalid_argument{"lwcli::view::calls given nullptr"};
+    return std::make_shared<calls_>(std::move(stats));
+  }
+}} // lwcli // view
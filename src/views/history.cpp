@@ -33,12 +33,16 @@
 #include <ftxui/dom/table.hpp>
 #include <lws_frontend.h>
 #include <map>
+#include <optional>
 #include <unordered_map>
 
+#include "cache/history.h"
 #include "components/table.h"
 #include "decorate/overlay.h"
 #include "events.h"
 #include "history.h"
+#include "timer.h"
+#include "trace.h"
 #include "translate.h"
 
 namespace lwcli { namespace view
@@ -73,7 +77,7 @@ namespace lwcli { namespace view
       bool OnEvent(ftxui::Event event) override final
       {
         if (event == event::refresh_wallet)
-          return on_refresh(history_->transaction(hash_));
+          return on_refresh(LWCLI_TRACE_CALL("TransactionHistory::transaction", history_->transaction(hash_)));
         else if (event == ftxui::Event::CtrlQ)
           throw event::close{};
         return container_->OnEvent(std::move(event));
@@ -84,9 +88,9 @@ namespace lwcli { namespace view
         auto buttons = ftxui::hcenter(buttons_->Render());
         if (!info_)
         {
-          return ftxui::window(
+          return decorate::window(
             ftxui::text(_("Tx ") + hash_),
-            ftxui::vbox(std::move(buttons), ftxui::separator(), ftxui::text("No longer available"))
+            ftxui::vbox(std::move(buttons), decorate::separator(), ftxui::text("No longer available"))
           );
         }
 
@@ -152,11 +156,11 @@ namespace lwcli { namespace view
         else if (info_->isPending())
           vertical.push_back(ftxui::inverted(ftxui::hcenter(ftxui::text(_("PENDING")))));
         else
-          vertical.push_back(ftxui::separator());
+          vertical.push_back(decorate::separator());
 
         vertical.push_back(ftxui::gridbox(std::move(grid)));
 
-        return ftxui::window(ftxui::text(_("Tx ") + hash_), ftxui::vbox(std::move(vertical)));
+        return decorate::window(ftxui::text(_("Tx ") + hash_), ftxui::vbox(std::move(vertical)));
       }
 
       bool on_refresh(const Monero::TransactionInfo* info)
@@ -201,15 +205,48 @@ namespace lwcli { namespace view
       }
     };
 
+    using tx_list = std::vector<const Monero::TransactionInfo*>;
+
+    //! \return Transactions of `account`, newest first. Refreshes the backend history.
+    tx_list fetch(const std::shared_ptr<Monero::Wallet>& wallet, const std::uint32_t account)
+    {
+      Monero::TransactionHistory* tx_history = LWCLI_TRACE_CALL("Wallet::history", wallet->history());
+      if (!tx_history)
+        throw std::runtime_error{"unexpeted history nullptr"};
+      LWCLI_TRACE_CALL("TransactionHistory::refresh", tx_history->refresh());
+
+      std::map<std::pair<std::uint64_t, std::string>, const Monero::TransactionInfo*, std::greater<>> ordered;
+      const auto history = LWCLI_TRACE_CALL("TransactionHistory::getAll", tx_history->getAll());
+      for (const Monero::TransactionInfo* tx : history)
+      {
+        if (!tx)
+          throw std::runtime_error{"unexpected tx_info nullptr"};
+
+        if (tx->subaddrAccount() == account)
+          ordered.try_emplace({tx->blockHeight(), tx->hash()}, tx);
+      }
+
+      tx_list out;
+      out.reserve(ordered.size());
+      for (const auto& entry : ordered)
+        out.push_back(entry.second);
+      return out;
+    }
+
     class history_ final : public ftxui::ComponentBase
     {
       const std::shared_ptr<Monero::Wallet> wallet_;
+      std::shared_ptr<cache::history> cache_;
       ftxui::Component table_;
       ftxui::Component overlay_;
       const std::string title1_;
       const std::string title2_;
-      std::vector<const Monero::TransactionInfo*> row_map_;
+      ftxui::Element title_; //!< Set when deferred, rebuilt on `event::refresh_wallet`
+      tx_list row_map_;
+      std::optional<cache::account_rows> cold_; //!< Shown until `loading_` finishes
+      timer::background<tx_list> loading_;
       const std::uint32_t account_;
+      bool stale_; //!< Refresh arrived during `loading_`
 
       bool Focusable() const override final { return true; }
       ftxui::Component ActiveChild() override final
@@ -219,51 +256,76 @@ namespace lwcli { namespace view
         return table_;
       }
 
+      ftxui::Element make_title() const
+      {
+        return ftxui::text(title1_ + LWCLI_TRACE_CALL("Wallet::getSubaddressLabel", wallet_->getSubaddressLabel(account_, 0)) + title2_);
+      }
+
       ftxui::Element get_title() const
       {
-        // UI can modify label at any time
-        return ftxui::text(title1_ + wallet_->getSubaddressLabel(account_, 0) + title2_);
+        // UI can modify label at any time, but a deferred wallet may be in `init`
+        if (title_)
+          return title_;
+        return make_title();
       }
 
       void load_history()
       {
-        Monero::TransactionHistory* tx_history = wallet_->history();
-        if (!tx_history)
-          throw std::runtime_error{"unexpeted history nullptr"};
-        tx_history->refresh();
-
-        std::map<std::pair<std::uint64_t, std::string>, const Monero::TransactionInfo*, std::greater<>> ordered;
-        const auto history = tx_history->getAll();
-        for (const Monero::TransactionInfo* tx : history)
-        {
-          if (!tx)
-            throw std::runtime_error{"unexpected tx_info nullptr"};
+        row_map_ = fetch(wallet_, account_);
+      }
 
-          if (tx->subaddrAccount() == account_)
-            ordered.try_emplace({tx->blockHeight(), tx->hash()}, tx);
-        }
+      //! Swaps cached rows for live rows once the background load is done
+      void check_loading()
+      {
+        if (!loading_.valid() || !loading_.ready())
+          return;
 
-        row_map_.clear();
-        row_map_.reserve(ordered.size());
-        for (const auto& entry : ordered)
-          row_map_.push_back(entry.second);
+        tx_list loaded = loading_.get();
+        if (stale_)
+        {
+          // keep showing cached rows; the next `fetch` replaces `loaded`
+          stale_ = false;
+          loading_ = timer::async_redraw(fetch, wallet_, account_);
+          return;
+        }
+        row_map_ = std::move(loaded);
+        cold_.reset();
       }
 
     public:
-      explicit history_(std::shared_ptr<Monero::Wallet>&& wallet, std::uint32_t account)
+      explicit history_(std::shared_ptr<Monero::Wallet>&& wallet, std::uint32_t account, std::shared_ptr<cache::history>&& cache, const bool deferred)
         : ftxui::ComponentBase(),
           wallet_(std::move(wallet)),
+          cache_(std::move(cache)),
           table_(),
           overlay_(nullptr),
           title1_(_("Account #") + std::to_string(account) + " / "),
           title2_(" / " + wallet_->address(account, 0).substr(0, 20) + "..."),
+          title_(nullptr),
           row_map_(),
-          account_(account)
+          cold_(),
+          loading_(),
+          account_(account),
+          stale_(false)
       {
         if (!wallet_)
           throw std::invalid_argument{"lwcli::view::history given nullptr"};
- 
-        load_history();
+
+        const cache::account_rows* const cached = cache_ ? cache_->find(account_) : nullptr;
+        if (cached)
+          cold_ = *cached;
+        else if (deferred)
+          cold_.emplace(); // nothing to show until the first refresh
+
+        if (deferred)
+          title_ = make_title();
+        else
+        {
+          if (cold_)
+            loading_ = timer::async_redraw(fetch, wallet_, account_);
+          else
+            load_history();
+        }
 
         // perform transalation lookup once
         table_ = component::table(
@@ -275,9 +337,32 @@ namespace lwcli { namespace view
         Add(table_);
       }
 
+      //! Late cache from a background open; cached rows replace an empty wait
+      void set_cache(std::shared_ptr<cache::history> cache)
+      {
+        cache_ = std::move(cache);
+        const cache::account_rows* const cached = cache_ ? cache_->find(account_) : nullptr;
+        if (cached && cold_)
+          cold_ = *cached;
+      }
+
+      //! Hands the live rows to the cache, which writes them when the wallet closes
+      virtual ~history_() noexcept override final
+      {
+        if (!cache_ || cold_)
+          return;
+        try
+        {
+          const std::string balance = lwsf::displayAmount(LWCLI_TRACE_CALL("Wallet::balance", wallet_->balance(account_)));
+          cache_->update(account_, {balance, transaction_list()});
+        }
+        catch (...)
+        {}
+      }
+
       bool add_overlay(ftxui::Event& e, const std::size_t i)
       {
-        if (!overlay_ && (e == ftxui::Event::Return || event::is_left_click(e)))
+        if (!overlay_ && !cold_ && (e == ftxui::Event::Return || event::is_left_click(e)))
         {
           overlay_ = std::make_shared<tx_details>(wallet_->history(), row_map_.at(i));
           Add(overlay_);
@@ -288,11 +373,19 @@ namespace lwcli { namespace view
 
       bool OnEvent(ftxui::Event event) override final
       {
+        LWCLI_TRACE("history_::OnEvent");
         try
         {
           if (event == event::refresh_wallet)
           {
-            load_history();
+            if (loading_.valid())
+              stale_ = true; // `fetch` is already running; reload after it
+            else if (cold_)
+              loading_ = timer::async_redraw(fetch, wallet_, account_); // first load when deferred
+            else
+              load_history();
+            if (title_)
+              title_ = make_title();
             if (overlay_)
               overlay_->OnEvent(std::move(event));
             return true;
@@ -321,6 +414,9 @@ namespace lwcli { namespace view
 
       std::vector<std::vector<std::string>> transaction_list()
       {
+        if (cold_)
+          return cold_->rows;
+
         std::vector<std::vector<std::string>> rows;
         rows.reserve(row_map_.size() + 2);
 
@@ -357,7 +453,7 @@ namespace lwcli { namespace view
           {
             const std::uint32_t index = *subaddrs.begin();
             if (index)
-              label = wallet_->getSubaddressLabel(account_, index);
+              label = LWCLI_TRACE_CALL("Wallet::getSubaddressLabel", wallet_->getSubaddressLabel(account_, index));
           }
 
           rows.push_back({
@@ -377,9 +473,20 @@ namespace lwcli { namespace view
 
       ftxui::Element OnRender() override final
       {
+        LWCLI_TRACE("history_::OnRender");
+        check_loading();
+
+        ftxui::Element balance;
+        if (cold_ && cold_->balance.empty())
+          balance = ftxui::text(std::string{_("Balance: ")} + _("loading..."));
+        else if (cold_)
+          balance = ftxui::text(_("Balance: ") + cold_->balance + _(" (last known, loading...)"));
+        else
+          balance = ftxui::text(_("Balance: ") + lwsf::displayAmount(LWCLI_TRACE_CALL("Wallet::balance", wallet_->balance(account_))));
+
         auto table = ftxui::vbox({
           get_title(),
-          ftxui::text(_("Balance: ") + lwsf::displayAmount(wallet_->balance(account_))),
+          std::move(balance),
           table_->Render() | ftxui::vscroll_indicator | ftxui::yframe | ftxui::center | ftxui::flex
         });
         if (!overlay_)
@@ -389,8 +496,15 @@ namespace lwcli { namespace view
     };
   } // anonymous
 
-  ftxui::Component history(std::shared_ptr<Monero::Wallet> wallet, std::uint32_t account)
+  ftxui::Component history(std::shared_ptr<Monero::Wallet> wallet, std::uint32_t account, std::shared_ptr<cache::history> cache, const bool deferred)
+  {
+    return std::make_shared<history_>(std::move(wallet), account, std::move(cache), deferred);
+  }
+
+  void history_cache(const ftxui::Component& view, std::shared_ptr<cache::history> cache)
   {
-    return std::make_shared<history_>(std::move(wallet), account);
+    const auto real = std::dynamic_pointer_cast<history_>(view);
+    if (real)
+      real->set_cache(std::move(cache));
   }
 }} // lwcli // view
@@ -30,12 +30,20 @@
 
 #include <cstdint>
 #include <ftxui/component/component_base.hpp>
+#include <memory>
 
 namespace Monero { class Wallet; }
+namespace lwcli { namespace cache { class history; }}
 namespace lwcli { namespace view
 {
-  //! Shows Transaction History
-  ftxui::Component history(std::shared_ptr<Monero::Wallet> wallet, std::uint32_t account);
+  /*! Shows Transaction History. With `cache`, the last known rows are drawn
+    at once while the backend loads, and the cache is kept current. With
+    `deferred`, `wallet` is not used after construction until the first
+    `event::refresh_wallet`, so it can be connected in the background. */
+  ftxui::Component history(std::shared_ptr<Monero::Wallet> wallet, std::uint32_t account, std::shared_ptr<cache::history> cache = nullptr, bool deferred = false);
+
+  //! Gives a `history` view its `cache` once opened; no-op for other views
+  void history_cache(const ftxui::Component& view, std::shared_ptr<cache::history> cache);
 
 }} // lwscli // view
 
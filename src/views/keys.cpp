@@ -95,12 +95,12 @@ namespace lwcli { namespace view
           vbox.push_back(warning_);
 
         vbox.push_back(seed_);
-        vbox.push_back(ftxui::separator());
+        vbox.push_back(decorate::separator());
         vbox.push_back(grid_);
-        vbox.push_back(ftxui::separator());
+        vbox.push_back(decorate::separator());
         vbox.push_back(decorate::banner(ui_->Render()));
         
-        return ftxui::window(title_, ftxui::vbox(std::move(vbox)));
+        return decorate::window(title_, ftxui::vbox(std::move(vbox)));
       }
     };
   }
@@ -0,0 +1,143 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "lock.h"
+
+#include <ftxui/component/component.hpp>
+#include <ftxui/component/event.hpp>
+#include <lws_frontend.h>
+
+#include "decorate/overlay.h"
+#include "events.h"
+#include "translate.h"
+
+namespace lwcli { namespace view
+{
+  namespace
+  {
+    ftxui::ButtonOption ascii() { return ftxui::ButtonOption::Ascii(); }
+
+    class lock_ final : public ftxui::ComponentBase
+    {
+      std::string password_;
+      std::string error_;
+      const std::shared_ptr<Monero::Wallet> wal_;
+      bool* const close_wallet_;
+      const ftxui::Element title_;
+      const ftxui::Component buttons_;
+      const ftxui::Component prompt_;
+      const ftxui::Component ui_;
+      const ftxui::Element display_;
+
+      bool Focusable() const override final { return true; }
+      ftxui::Component ActiveChild() override final { return ui_; }
+
+      static ftxui::Component password(std::string* pass, std::function<void()> on_enter)
+      {
+        auto opt = ftxui::InputOption::Default();
+        opt.password = true;
+        opt.multiline = false;
+        opt.on_enter = std::move(on_enter);
+        return ftxui::Input(pass, std::move(opt));
+      }
+
+      void check()
+      {
+        // wallet stays open, so only compare against the in-memory password
+        const bool valid = wal_->getPassword() == password_;
+        password_.clear();
+        if (!valid)
+        {
+          error_ = _("Invalid Password");
+          return;
+        }
+        throw event::close{};
+      }
+
+      [[noreturn]] void close_wallet()
+      {
+        *close_wallet_ = true;
+        throw event::close{};
+      }
+
+    public:
+      explicit lock_(std::shared_ptr<Monero::Wallet>&& wal, bool* close_wallet)
+        : ftxui::ComponentBase(),
+          password_(),
+          error_(),
+          wal_(std::move(wal)),
+          close_wallet_(close_wallet),
+          title_(ftxui::text(_("Wallet Locked Due to Inactivity"))),
+          buttons_(
+            ftxui::Container::Horizontal({
+              ftxui::Button(_("Close Wallet"), [this] () { this->close_wallet(); }, ascii()),
+              ftxui::Button(_("Unlock"), [this] () { check(); }, ascii())
+            })
+          ),
+          prompt_(password(std::addressof(password_), [this] { check(); })),
+          ui_(ftxui::Container::Vertical({buttons_, prompt_})),
+          display_(ftxui::text(_("Password: ")))
+      {
+        if (!wal_ || !close_wallet_)
+          throw std::invalid_argument{"lwcli::view::lock given nullptr"};
+        Add(ui_);
+        prompt_->TakeFocus();
+      }
+
+      bool OnEvent(ftxui::Event event) override final
+      {
+        if (!event.is_mouse())
+          error_.clear();
+        if (event == ftxui::Event::CtrlQ)
+          close_wallet();
+        ui_->OnEvent(std::move(event));
+        return true;
+      }
+
+      ftxui::Element OnRender() override final
+      {
+        ftxui::Element separator;
+        if (error_.empty())
+          separator = decorate::separator();
+        else
+          separator = ftxui::text(error_) | ftxui::inverted;
+
+        return decorate::overlay(decorate::window(title_, ftxui::vbox({
+          ftxui::hcenter(buttons_->Render()),
+          separator,
+          ftxui::hbox({display_, prompt_->Render()})
+        })));
+      }
+    };
+  } // anonymous
+
+  ftxui::Component lock(std::shared_ptr<Monero::Wallet> wal, bool* close_wallet)
+  {
+    return std::make_shared<lock_>(std::move(wal), close_wallet);
+  }
+}} // lwcli // view
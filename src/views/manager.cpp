@@ -39,26 +39,22 @@
 #include "decorate/overlay.h"
 #include "events.h"
 #include "lwcli_config.h"
+#include "proxy/cache.h"
+#include "proxy/instrument.h"
+#include "restore_height.h"
+#include "trace.h"
 #include "translate.h"
 #include "util.h"
 #include "views/history.h"
 #include "views/keys.h"
+#include "views/lock.h"
+#include "wallet_config.h"
+#include "wallet_open.h"
 
 namespace lwcli { namespace view
 {
   namespace
   {
-    struct close_wallet
-    {
-      std::shared_ptr<Monero::WalletManager> wm;
-
-      void operator()(Monero::Wallet* ptr) const
-      {
-        if (ptr)
-          wm->closeWallet(ptr, true /* store */);
-      }
-    };
-
     std::string get_home()
     {
       const char* home = std::getenv("HOME");
@@ -85,19 +81,13 @@ namespace lwcli { namespace view
       return ftxui::Input(str, std::move(opt));
     }
 
-    std::shared_ptr<Monero::Wallet> prep_wallet(std::shared_ptr<Monero::WalletManager> wm, Monero::Wallet* ptr, std::string* error)
+    //! Optional date field, overrides height when filled
+    ftxui::Component date_input(std::string* str)
     {
-      std::unique_ptr<Monero::Wallet> data{ptr};
-      if (!data)
-        throw std::runtime_error{"unexpected wallet nullptr"};
- 
-      int status = 0;
-      error->clear();
-      data->statusWithErrorString(status, *error);
-      if (status != Monero::Wallet::Status_Ok)
-        return nullptr;
-
-      return {data.release(), close_wallet{std::move(wm)}};
+      auto opt = ftxui::InputOption::Default();
+      opt.placeholder = "YYYY-MM-DD";
+      opt.multiline = false;
+      return ftxui::Input(str, std::move(opt));
     }
 
     struct wallet_base
@@ -120,24 +110,30 @@ namespace lwcli { namespace view
       bool subaddresses;
 
       new_wallet(std::string default_file)
-        : wallet_base(std::move(default_file)), confirm(), language(config::default_language), server(config::server::default_url), proxy(), ssl(false), subaddresses(true)
+        : wallet_base(std::move(default_file)),
+          confirm(),
+          language(config::default_language),
+          server(config::profile.get<config::keys::url>()),
+          proxy(config::profile.get<config::keys::proxy>()),
+          ssl(config::profile.get<config::keys::ssl>()),
+          subaddresses(true)
       {}
 
       void setup(Monero::Wallet& wal)
       {
-        wal.setCacheAttribute(std::string{config::server::refresh_interval}, std::to_string(config::server::default_refresh_interval.count()));
-        wal.setCacheAttribute(std::string{config::server::url}, server);
-        wal.setCacheAttribute(std::string{config::server::proxy}, proxy);
-        wal.setCacheAttribute(std::string{config::server::ssl}, std::to_string(int(ssl)));
-
-        const std::uint32_t major_lookahead = subaddresses ?
-          config::default_major_lookahead : 0;
-        const std::uint32_t minor_lookahead = subaddresses ?
-          config::default_minor_lookahead : 0;
-
-        wal.setCacheAttribute(std::string{config::major_lookahead}, std::to_string(major_lookahead));
-        wal.setCacheAttribute(std::string{config::minor_lookahead}, std::to_string(minor_lookahead));
-        wal.setSubaddressLookahead(major_lookahead, minor_lookahead);
+        namespace keys = config::keys;
+        config::wallet_store settings = config::profile;
+        settings.set<keys::url>(server);
+        settings.set<keys::proxy>(proxy);
+        settings.set<keys::ssl>(ssl);
+        if (!subaddresses)
+        {
+          settings.set<keys::major_lookahead>(0);
+          settings.set<keys::minor_lookahead>(0);
+        }
+        settings.store(wal);
+
+        wal.setSubaddressLookahead(settings.get<keys::major_lookahead>(), settings.get<keys::minor_lookahead>());
       }
     };
 
@@ -147,29 +143,22 @@ namespace lwcli { namespace view
       std::shared_ptr<Monero::Wallet> wal;
       ftxui::Component overlay;
       std::string error;
+      bool connect; //!< `wal` still needs `init_wallet`, done by the wallet view
 
       start_state(std::shared_ptr<Monero::WalletManager>&& wm)
-        : wm(std::move(wm)), wal(nullptr), overlay(nullptr), error()
+        : wm(std::move(wm)), wal(nullptr), overlay(nullptr), error(), connect(false)
       {}
     };
 
-    bool init_wallet(Monero::Wallet& wal, std::string* error)
+    //! \return Restore height from `date` (YYYY-MM-DD) if given, otherwise `height`.
+    std::optional<std::uint64_t> get_restore_height(const std::string& height, const std::string& date)
     {
-      auto refresh = from_string(wal.getCacheAttribute(std::string{config::server::refresh_interval}));
-      if (!refresh)
-        refresh = config::server::default_refresh_interval.count();
-      wal.setAutoRefreshInterval(std::chrono::milliseconds{std::chrono::seconds{*refresh}}.count());
-
-      auto ssl = from_string(wal.getCacheAttribute(std::string{config::server::ssl}));
-      if (!ssl)
-        ssl = 0;
-
-      if (!wal.init(wal.getCacheAttribute(std::string{config::server::url}), 0, "", "", *ssl, true, wal.getCacheAttribute(std::string{config::server::proxy})))
-      {
-        *error = "Failure to initialize" + wal.errorString();
-        return false;
-      }
-      return true;
+      if (date.empty())
+        return from_string(height);
+      const auto timestamp = restore::from_date(date);
+      if (!timestamp)
+        return std::nullopt;
+      return restore::height(config::network, *timestamp);
     }
 
     using option_set = std::pair<std::vector<std::pair<ftxui::Element, ftxui::Component>>, ftxui::Component>;
@@ -189,17 +178,15 @@ namespace lwcli { namespace view
       const auto load_action = [enclosed] () {
         auto prepped = prep_wallet(
           enclosed->state->wm,
-          enclosed->state->wm->openWallet(enclosed->config.file, enclosed->config.password, config::network),
+          LWCLI_TRACE_CALL("WalletManager::openWallet", enclosed->state->wm->openWallet(enclosed->config.file, enclosed->config.password, config::network)),
           &enclosed->state->error
         );
         if (prepped)
         {
-          if (init_wallet(*prepped, &enclosed->state->error))
-          {
-            enclosed->config.password.clear();
-            prepped->startRefresh();
-            enclosed->state->wal = prepped;
-          }
+          // connect behind the wallet view, so a slow server does not hide it
+          enclosed->config.password.clear();
+          enclosed->state->connect = !config::offline;
+          enclosed->state->wal = prepped;
         }
       };
 
@@ -236,7 +223,7 @@ namespace lwcli { namespace view
           {
             auto prepped = prep_wallet(
               enclosed->state->wm,
-              enclosed->state->wm->createWallet(enclosed->config.file, enclosed->config.password, enclosed->config.language, config::network),
+              LWCLI_TRACE_CALL("WalletManager::createWallet", enclosed->state->wm->createWallet(enclosed->config.file, enclosed->config.password, enclosed->config.language, config::network)),
               &enclosed->state->error
             );
             if (prepped)
@@ -249,7 +236,8 @@ namespace lwcli { namespace view
                   enclosed->config.password.clear();
                   enclosed->config.confirm.clear();
                   enclosed->state->overlay = view::keys(prepped, true /* show warning */);
-                  prepped->startRefresh();
+                  if (!config::offline)
+                    prepped->startRefresh();
                   enclosed->state->wal = prepped;
                 }
               }
@@ -283,18 +271,19 @@ namespace lwcli { namespace view
         start_state* state;
         std::string mnemonic;
         std::string height;
+        std::string date;
         new_wallet config;
 
         options(std::string default_file, start_state* state)
-          : state(state), mnemonic(), height("0"), config(std::move(default_file))
+          : state(state), mnemonic(), height("0"), date(), config(std::move(default_file))
         {}
       };
       auto enclosed = std::make_shared<options>(std::move(default_file), state);
       auto recover = ftxui::Button("Recover", [enclosed] () {
-        const auto height = from_string(enclosed->height);
+        const auto height = get_restore_height(enclosed->height, enclosed->date);
         if (!height)
         {
-          enclosed->state->error = "Invalid Height";
+          enclosed->state->error = "Invalid Height or Restore Date";
           return;
         }
         if (!enclosed->config.file.empty())
@@ -310,7 +299,7 @@ namespace lwcli { namespace view
           {
             auto prepped = prep_wallet(
               enclosed->state->wm,
-              enclosed->state->wm->recoveryWallet(enclosed->config.file, enclosed->config.password, enclosed->mnemonic, config::network, *height),
+              LWCLI_TRACE_CALL("WalletManager::recoveryWallet", enclosed->state->wm->recoveryWallet(enclosed->config.file, enclosed->config.password, enclosed->mnemonic, config::network, *height)),
               &enclosed->state->error
             );
             if (prepped)
@@ -323,7 +312,8 @@ namespace lwcli { namespace view
                   enclosed->mnemonic.clear();
                   enclosed->config.password.clear();
                   enclosed->config.confirm.clear();
-                  prepped->rescanBlockchainAsync();
+                  if (!config::offline)
+                    prepped->rescanBlockchainAsync();
                   enclosed->state->wal = prepped;
                 }
               }
@@ -344,6 +334,7 @@ namespace lwcli { namespace view
           {ftxui::text(_("Confirm: ")), password(&enclosed->config.confirm)},
           {ftxui::text(_("Mnemonic: ")), last_input(&enclosed->mnemonic)},
           {ftxui::text(_("Height: ")), last_input(&enclosed->height)},
+          {ftxui::text(_("Restore Date: ")), date_input(&enclosed->date)},
           {ftxui::text(_("API Server: ")), last_input(&enclosed->config.server)},
           {ftxui::text(_("Proxy: ")), last_input(&enclosed->config.proxy)},
           {ftxui::text(_("Options: ")), ftxui::Container::Horizontal({ftxui::Checkbox(_("TLS/SSL Cert Check "), &enclosed->config.ssl), ftxui::Checkbox(_("Subaddresses"), &enclosed->config.subaddresses)})}
@@ -361,18 +352,19 @@ namespace lwcli { namespace view
         std::string view_key;
         std::string address;
         std::string height;
+        std::string date;
         new_wallet config;
 
         options(std::string default_file, start_state* state)
-          : state(state), spend_key(), view_key(), address(), height("0"), config(std::move(default_file))
+          : state(state), spend_key(), view_key(), address(), height("0"), date(), config(std::move(default_file))
         {}
       };
       auto enclosed = std::make_shared<options>(std::move(default_file), state);
       auto recover = ftxui::Button(_("Recover (Broken)"), [enclosed] () {
-        const auto height = from_string(enclosed->height);
+        const auto height = get_restore_height(enclosed->height, enclosed->date);
         if (!height)
         {
-          enclosed->state->error = "Invalid Height";
+          enclosed->state->error = "Invalid Height or Restore Date";
           return;
         }
         if (!enclosed->config.file.empty())
@@ -388,7 +380,7 @@ namespace lwcli { namespace view
           {
             auto prepped = prep_wallet(
               enclosed->state->wm,
-              enclosed->state->wm->createWalletFromKeys(
+              LWCLI_TRACE_CALL("WalletManager::createWalletFromKeys", enclosed->state->wm->createWalletFromKeys(
                 enclosed->config.file,
                 enclosed->config.password,
                 enclosed->config.language,
@@ -397,7 +389,7 @@ namespace lwcli { namespace view
                 enclosed->address,
                 enclosed->view_key,
                 enclosed->spend_key
-              ),
+              )),
               &enclosed->state->error
             );
             if (prepped)
@@ -410,7 +402,8 @@ namespace lwcli { namespace view
                   enclosed->spend_key.clear();
                   enclosed->config.password.clear();
                   enclosed->config.confirm.clear();
-                  prepped->rescanBlockchainAsync();
+                  if (!config::offline)
+                    prepped->rescanBlockchainAsync();
                   enclosed->state->wal = prepped;
                 }
               }
@@ -433,6 +426,7 @@ namespace lwcli { namespace view
           {ftxui::text(_("View key: ")), last_input(&enclosed->view_key)},
           {ftxui::text(_("Address: ")), last_input(&enclosed->address)},
           {ftxui::text(_("Height: ")), last_input(&enclosed->height)},
+          {ftxui::text(_("Restore Date: ")), date_input(&enclosed->date)},
           {ftxui::text(_("Language: ")), last_input(&enclosed->config.language)},
           {ftxui::text(_("API Server: ")), last_input(&enclosed->config.server)},
           {ftxui::text(_("Proxy: ")), last_input(&enclosed->config.proxy)},
@@ -445,6 +439,7 @@ namespace lwcli { namespace view
     class start final : public ftxui::ComponentBase
     {
       std::shared_ptr<Monero::Wallet>* out_;
+      bool* connect_;
       const ftxui::Element title_;
       const ftxui::Element help_;
       const ftxui::Element disclaimer_;
@@ -473,9 +468,19 @@ namespace lwcli { namespace view
         return file.empty() || std::filesystem::exists(file, ec) ? 0 : 1;
       }
 
+      //! Moves the opened wallet to the manager
+      void hand_off()
+      {
+        *out_ = std::move(state_.wal);
+        *connect_ = state_.connect;
+        state_.wal.reset();
+        state_.connect = false;
+      }
+
     public:
-      explicit start(std::shared_ptr<Monero::WalletManager> wm, std::string&& file, std::shared_ptr<Monero::Wallet>* out)
+      explicit start(std::shared_ptr<Monero::WalletManager> wm, std::string&& file, std::shared_ptr<Monero::Wallet>* out, bool* connect)
         : out_(out),
+          connect_(connect),
           title_(ftxui::text("wmcli")),
           help_(decorate::banner(ftxui::text(_("Ctrl-Q to close active window, Ctrl-C close app immediately")))),
           disclaimer_(decorate::banner(ftxui::text(_("Beware of mouse events in Tmux/Screen")))),
@@ -536,25 +541,27 @@ namespace lwcli { namespace view
 
         // Delay showing wallet if options required overlay
         if (state_.wal && !state_.overlay)
-        {
-          *out_ = std::move(state_.wal);
-          state_.wal.reset();
-        }
+          hand_off();
 
         return true;
       }
 
       bool OnEvent(ftxui::Event event) override final
       {
-        if (!event.is_mouse())
+        // hiding the error is a change even if the event is otherwise ignored
+        const bool cleared = !event.is_mouse() && !state_.error.empty();
+        if (cleared)
           state_.error.clear();
 
         try
         {
           if (event == event::lock_wallet)
+          {
             state_.error = _("Wallet Locked Due to Inactivity");
+            return true;
+          }
           else if (state_.overlay)
-            return state_.overlay->OnEvent(std::move(event));
+            return state_.overlay->OnEvent(std::move(event)) || cleared;
           else if (event == ftxui::Event::CtrlQ)
             throw event::close{};
           else if (ui_->OnEvent(std::move(event)))
@@ -565,13 +572,12 @@ namespace lwcli { namespace view
           if (state_.overlay)
           {
             state_.overlay.reset();
-            *out_ = std::move(state_.wal);
-            state_.wal.reset();
+            hand_off();
             return true;
           }
           throw;
         }
-        return false;
+        return cleared;
       }
 
       ftxui::Element OnRender() override final
@@ -582,16 +588,16 @@ namespace lwcli { namespace view
           elements.push_back({elem.first, ftxui::xflex_grow(elem.second->Render())});
 
         ftxui::Elements out{
-          ftxui::text("  ○━━━━━━━━━━━━━━━━━┓") | ftxui::hcenter,
-          ftxui::text("┃ lwcli.cifro.codes ┃") | ftxui::hcenter,
-          ftxui::text("┗━━━━━━━━━━━━━━━━━▶  ") | ftxui::hcenter,
-          ftxui::separator(),
+          ftxui::text(config::low_bandwidth ? "  o-----------------+" : "  ○━━━━━━━━━━━━━━━━━┓") | ftxui::hcenter,
+          ftxui::text(config::low_bandwidth ? "| lwcli.cifro.codes |" : "┃ lwcli.cifro.codes ┃") | ftxui::hcenter,
+          ftxui::text(config::low_bandwidth ? "+----------------->  " : "┗━━━━━━━━━━━━━━━━━▶  ") | ftxui::hcenter,
+          decorate::separator(),
           help_,
           disclaimer_,
           decorate::banner(mode_->Render()),
-          ftxui::separator(),
+          decorate::separator(),
           ftxui::gridbox(std::move(elements)),
-          ftxui::separator(),
+          decorate::separator(),
           decorate::banner(completion_->Render())
         };
         if (!state_.error.empty())
@@ -608,42 +614,96 @@ namespace lwcli { namespace view
     {
       const std::shared_ptr<Monero::WalletManager> wm_;
       std::shared_ptr<Monero::Wallet> data_;
+      std::shared_ptr<Monero::Wallet> wal_;
+      bool connect_;
       const ftxui::Component start_;
       ftxui::Component wallet_;
+      ftxui::Component lock_;
+      bool close_wallet_;
 
       bool Focusable() const override final { return true; }
       ftxui::Component ActiveChild() override final
       {
+        if (lock_)
+          return lock_;
         if (wallet_)
           return wallet_;
         return start_;
       }
 
+      void on_lock(ftxui::Event event)
+      {
+        if (config::soft_lock)
+        {
+          // keep wallet open and syncing, only hide the UI
+          if (!lock_)
+            lock_ = view::lock(wal_, &close_wallet_);
+        }
+        else
+        {
+          wal_.reset();
+          wallet_.reset();
+          start_->OnEvent(std::move(event));
+        }
+      }
+
+      bool on_locked(ftxui::Event event)
+      {
+        if (event == event::refresh_wallet || event == event::send_async)
+          return wallet_->OnEvent(std::move(event));
+
+        try
+        {
+          return lock_->OnEvent(std::move(event));
+        }
+        catch (const event::close&)
+        {
+          lock_.reset();
+          if (!close_wallet_)
+            return true;
+          close_wallet_ = false;
+          throw;
+        }
+      }
+
     public:
       explicit manager_(std::shared_ptr<Monero::WalletManager>&& wm, std::string&& file)
         : ftxui::ComponentBase(),
           wm_(std::move(wm)),
           data_(nullptr),
-          start_(std::make_shared<start>(wm_, std::move(file), &data_)),
-          wallet_(nullptr)
+          wal_(nullptr),
+          connect_(false),
+          start_(std::make_shared<start>(wm_, std::move(file), &data_, &connect_)),
+          wallet_(nullptr),
+          lock_(nullptr),
+          close_wallet_(false)
       {}
 
       bool OnEvent(ftxui::Event event) override final
       {
+        LWCLI_TRACE("manager_::OnEvent");
+        bool handled = true;
         try
         {
           if (wallet_)
           {
             if (event == event::lock_wallet)
-            {
-              wallet_.reset();
-              start_->OnEvent(std::move(event));
-            }
+              on_lock(std::move(event));
+            else if (lock_)
+              return on_locked(std::move(event));
             else
               return wallet_->OnEvent(std::move(event));
           }
-          else if (event != event::lock_wallet && start_->OnEvent(std::move(event)) && data_)
-            wallet_ = view::wallet(wm_, std::move(data_));
+          else if (event == event::lock_wallet)
+            handled = false;
+          else if ((handled = start_->OnEvent(std::move(event))) && data_)
+          {
+            if (config::instrument)
+              data_ = std::make_shared<proxy::instrument>(std::move(data_));
+            data_ = std::make_shared<proxy::cache>(std::move(data_));
+            wal_ = data_;
+            wallet_ = view::wallet(wm_, std::move(data_), connect_);
+          }
           data_.reset();
         }
         catch (const event::close&)
@@ -651,13 +711,17 @@ namespace lwcli { namespace view
           if (!wallet_)
             throw;
           data_.reset();
+          wal_.reset();
           wallet_.reset();
         }
-        return true;
+        return handled;
       }
 
       ftxui::Element OnRender() override final
       {
+        LWCLI_TRACE("manager_::OnRender");
+        if (lock_)
+          return lock_->Render();
         if (wallet_)
           return wallet_->Render();
         return start_->Render();
@@ -29,18 +29,18 @@
 #include "wallet.h"
 
 #include <array>
-#include <ftxui/component/animation.hpp>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/table.hpp>
-#include <future>
 #include <lws_frontend.h>
 
 #include "components/table.h"
 #include "decorate/overlay.h"
 #include "events.h"
 #include "lwcli_config.h"
+#include "timer.h"
+#include "trace.h"
 #include "translate.h"
 #include "util.h"
 
@@ -52,6 +52,19 @@ namespace lwcli { namespace view
     using dest_group = std::pair<std::vector<std::string>, std::vector<std::uint64_t>>;
 
     constexpr const std::array<char, 4> spinner{{'|', '/', '-', '\\'}};
+    constexpr const std::chrono::milliseconds spin_interval{125};
+
+    /*! Spinner around `label`, re-armed only while rendered. Static with
+      `config::low_bandwidth` so the line is sent once. */
+    ftxui::Element progress(unsigned& frame, char const* const label)
+    {
+      if (config::low_bandwidth)
+        return ftxui::text(std::string{label} + "...");
+
+      frame = (frame + 1) % spinner.size();
+      timer::animate(spin_interval);
+      return ftxui::text(std::string{spinner[frame]} + label + spinner[frame]);
+    }
 
     ftxui::Component last_input(std::string* str)
     {
@@ -80,7 +93,7 @@ namespace lwcli { namespace view
       ftxui::Element info_;
       ftxui::Element error_;
       ftxui::Component buttons_;
-      std::future<bool> sending_;
+      timer::background<bool> sending_;
       unsigned animation_;
       bool sent_;
       bool closing_;
@@ -139,7 +152,7 @@ namespace lwcli { namespace view
           return tx->commit();
         };
 
-        sending_ = std::async(std::launch::async, tx_commit, tx_);
+        sending_ = timer::async_redraw(tx_commit, tx_);
       }
  
       bool OnEvent(ftxui::Event event) override final
@@ -176,7 +189,7 @@ namespace lwcli { namespace view
         bool animate = false;
         if (sending_.valid())
         {
-          if (sending_.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+          if (sending_.ready())
           {
             sent_ = sending_.get();
             if (!sent_)
@@ -191,9 +204,7 @@ namespace lwcli { namespace view
           else
           {
             animate = true; 
-            animation_ = (animation_ + 1) % spinner.size();
-            error_ = ftxui::text(std::string{spinner[animation_]} + _(" Sending ") + spinner[animation_]);
-            ftxui::animation::RequestAnimationFrame();
+            error_ = progress(animation_, _(" Sending "));
           }
         }
 
@@ -203,13 +214,13 @@ namespace lwcli { namespace view
         if (error_)
           rows.push_back(decorate::banner(error_) | ftxui::inverted); 
         else
-          rows.push_back(ftxui::separator());
+          rows.push_back(decorate::separator());
 
         if (closing_)
           rows.push_back(ftxui::text(_("...Waiting for Tx Send...")));
         rows.push_back(info_);
 
-        return ftxui::window(title_, ftxui::vbox(std::move(rows)));
+        return decorate::window(title_, ftxui::vbox(std::move(rows)));
       }
     };
 
@@ -243,8 +254,8 @@ namespace lwcli { namespace view
       ftxui::Element error_;
       ftxui::Component ui_;
       ftxui::Element cached_;
-      std::future<std::tuple<std::string, std::shared_ptr<dest_pair>, bool>> oa_;
-      std::future<std::tuple<std::shared_ptr<Monero::PendingTransaction>, dest_group, std::string>> tx_;
+      timer::background<std::tuple<std::string, std::shared_ptr<dest_pair>, bool>> oa_;
+      timer::background<std::tuple<std::shared_ptr<Monero::PendingTransaction>, dest_group, std::string>> tx_;
       const std::uint32_t account_;
       bool closing_;
 
@@ -268,7 +279,7 @@ namespace lwcli { namespace view
         : ftxui::ComponentBase(),
           wm_(std::move(wm)),
           wal_(std::move(wal)),
-          title_(ftxui::text(_("Send from account #") + std::to_string(account) + " (" + lwsf::displayAmount(wal_->unlockedBalance(account)) + " XMR available)")),
+          title_(ftxui::text(_("Send from account #") + std::to_string(account) + " (" + lwsf::displayAmount(LWCLI_TRACE_CALL("Wallet::unlockedBalance", wal_->unlockedBalance(account))) + " XMR available)")),
           priority_names_({_("Auto"), _("Unimportant"), _("Normal"), _("Elevated"), _("Priority")}),
           dests_(),
           dests_ui_(),
@@ -380,7 +391,7 @@ namespace lwcli { namespace view
 
             if (!wm_)
               throw std::runtime_error{"WalletManager is nullptr"};
-            oa_ = std::async(std::launch::async, oa_lookup, wm_, dest->second);
+            oa_ = timer::async_redraw(oa_lookup, wm_, dest->second);
             return;
           }
           dests.first.push_back(dest->second);
@@ -400,7 +411,7 @@ namespace lwcli { namespace view
             amounts = dests.second;
 
           std::shared_ptr<Monero::PendingTransaction> tx{
-            wal->createTransactionMultDest(dests.first, {}, std::move(amounts), 0 /*mixin_count*/, Monero::PendingTransaction::Priority(priority), account),
+            LWCLI_TRACE_CALL("Wallet::createTransactionMultDest", wal->createTransactionMultDest(dests.first, {}, std::move(amounts), 0 /*mixin_count*/, Monero::PendingTransaction::Priority(priority), account)),
             dispose
           };
           if (!tx)
@@ -410,11 +421,12 @@ namespace lwcli { namespace view
           return {nullptr, {}, tx->errorString()};
         };
 
-        tx_ = std::async(std::launch::async, tx_construct, wal_, std::move(dests), account_, priority_);
+        tx_ = timer::async_redraw(tx_construct, wal_, std::move(dests), account_, priority_);
       }
 
       bool OnEvent(ftxui::Event event) override final
       {
+        LWCLI_TRACE("send_::OnEvent");
         const bool is_waiting = oa_.valid() || tx_.valid();
         try
         {
@@ -447,11 +459,12 @@ namespace lwcli { namespace view
 
       ftxui::Element OnRender() override final
       {
+        LWCLI_TRACE("send_::OnRender");
         bool animate = false;
         if (oa_.valid() || tx_.valid())
         {
           animate = true;
-          if (oa_.valid() && oa_.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+          if (oa_.valid() && oa_.ready())
           {
             auto oa = oa_.get();
             error_.reset();
@@ -471,7 +484,7 @@ namespace lwcli { namespace view
 
             animate = oa_.valid();
           }
-          else if (tx_.valid() && tx_.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+          else if (tx_.valid() && tx_.ready())
           {
             animate = false;
             auto tx = tx_.get();
@@ -485,9 +498,7 @@ namespace lwcli { namespace view
           {
             char const* const label = oa_.valid() ?
               _(" OpenAlias Lookup ") : _(" Constructing Transaction ");
-            animation_ = (animation_ + 1) % spinner.size();
-            error_ = ftxui::text(std::string{spinner[animation_]} + label + spinner[animation_]);
-            ftxui::animation::RequestAnimationFrame();
+            error_ = progress(animation_, label);
           }
           else
           {
@@ -508,13 +519,13 @@ namespace lwcli { namespace view
           if (error_)
             rows.push_back(decorate::banner(error_) | ftxui::inverted);
           else
-            rows.push_back(ftxui::separator());
+            rows.push_back(decorate::separator());
 
           if (!animate)
           {
             rows.push_back(priority_menu_->Render() | ftxui::hcenter);
             //rows.push_back(ftxui::hbox({ftxui::filler(), priority_menu_->Render(), ftxui::filler()}));
-            rows.push_back(ftxui::separator());
+            rows.push_back(decorate::separator());
           }
 
           if (!closing_)
@@ -530,7 +541,7 @@ namespace lwcli { namespace view
               row.push_back(std::get<1>(e)->Render());
               if (!animate)
               {
-                row.push_back(ftxui::separator());
+                row.push_back(decorate::separator("|"));
                 row.push_back(std::get<2>(e)->Render());
                 row.push_back(std::get<3>(e)->Render());
               }
@@ -541,7 +552,7 @@ namespace lwcli { namespace view
           else
             rows.push_back(ftxui::text(_("...Cleaning Up...")) | ftxui::hcenter);
 
-          cached_ = ftxui::window(title_, ftxui::vbox(std::move(rows)));
+          cached_ = decorate::window(title_, ftxui::vbox(std::move(rows)));
           return cached_;
         }
         return ftxui::dbox(cached_, decorate::overlay(overlay_->Render()));
@@ -31,95 +31,117 @@
 #include <charconv>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
+#include <ftxui/component/screen_interactive.hpp>
 #include <lws_frontend.h>
 
 #include "decorate/overlay.h"
 #include "events.h"
 #include "lwcli_config.h"
+#include "net/failover.h"
+#include "net/probe.h"
+#include "timer.h"
+#include "trace.h"
 #include "translate.h"
-#include "util.h"
 #include "views/history.h"
+#include "wallet_config.h"
 
 
 namespace lwcli { namespace view
 {
   namespace
   {
-    bool set_proxy(Monero::Wallet& wal, const std::string& proxy)
+    struct option
     {
-      return wal.setProxy(proxy);
-    }
+      const std::string_view path;
+      const std::string_view description;
+    };
 
-    bool set_url(Monero::Wallet& wal, const std::string& url)
+    const std::array<option, 7> options{{
+      {config::keys::url::name,              _("API Server")},
+      {config::keys::fallbacks::name,        _("Fallback Servers")},
+      {config::keys::refresh_interval::name, _("Refresh Interval (seconds)")},
+      {config::keys::ssl::name,              _("TLS/SSL Cert Check")},
+      {config::keys::proxy::name,            _("Proxy")},
+      {config::keys::major_lookahead::name,  _("Subaddress Major Lookahead")},
+      {config::keys::minor_lookahead::name,  _("Subaddress Minor Lookahead")}
+    }};
+
+    struct connection
     {
-      const bool is_ssl = bool(from_string(wal.getCacheAttribute(std::string{config::server::ssl})).value_or(0));
-      wal.init(url, 0, "", "", is_ssl, true, wal.getCacheAttribute(std::string{config::server::proxy}));
-      return true;
-    }
+      std::string url;
+      std::string fallbacks;
+      std::string proxy;
+      bool ssl;
+    };
 
-    bool set_refresh(Monero::Wallet& wal, const std::string& interval)
+    connection get_connection(const config::wallet_store& store)
     {
-      const auto number = from_string(interval);
-      if (!number)
-        return false;
-      wal.setAutoRefreshInterval(std::chrono::milliseconds{std::chrono::seconds{*number}}.count());
-      return true;
+      return {
+        store.get<config::keys::url>(),
+        store.get<config::keys::fallbacks>(),
+        store.get<config::keys::proxy>(),
+        store.get<config::keys::ssl>()
+      };
     }
 
-    bool set_ssl(Monero::Wallet& wal, const std::string& ssl)
+    bool connect(net::failover& servers, const connection& conn)
     {
-      const auto is_ssl = from_string(ssl);
-      if (!is_ssl)
-        return false;
-
-      wal.init(wal.getCacheAttribute(std::string{config::server::url}), 0, "", "", bool(*is_ssl), true, wal.getCacheAttribute(std::string{config::server::proxy}));
-      return true;
+      return servers.connect(net::endpoints(conn.url, conn.fallbacks), conn.proxy, conn.ssl);
     }
 
-    bool set_major_lookahead(Monero::Wallet& wal, const std::string& major)
+    /*! Runs off the UI thread. Tries `next` once, and restores `previous` on
+      failure so the wallet is never left without a server.
+      \return Empty on success, otherwise the error to display. */
+    std::string reconnect(const std::shared_ptr<Monero::Wallet>& wal, const std::shared_ptr<net::failover>& servers, const connection& next, const connection& previous)
     {
-      const auto major_integer = from_string(major);
-      if (!major_integer)
-        return false;
-
-      auto minor = from_string(wal.getCacheAttribute(std::string{config::minor_lookahead}));
-      if (!minor)
-        minor = config::default_minor_lookahead;
-
-      wal.setSubaddressLookahead(*major_integer, *minor);
-      return true;
+      if (connect(*servers, next))
+        return {};
+
+      std::string error = wal->errorString();
+      if (error.empty())
+        error = _("Unable to connect to ") + next.url;
+      if (!connect(*servers, previous))
+        error += _(" (restoring previous server also failed)");
+      return error;
     }
 
-    bool set_minor_lookahead(Monero::Wallet& wal, const std::string& minor)
+    std::string milliseconds(const std::chrono::microseconds value)
     {
-      const auto minor_integer = from_string(minor);
-      if (!minor_integer)
-        return false;
-
-      auto major = from_string(wal.getCacheAttribute(std::string{config::major_lookahead}));
-      if (!major)
-        major = config::default_major_lookahead;
-
-      wal.setSubaddressLookahead(*major, *minor_integer);
-      return true;
+      const auto tenths = (value.count() + 50) / 100;
+      return std::to_string(tenths / 10) + "." + std::to_string(tenths % 10) + "ms";
     }
 
-    struct option
+    ftxui::Element describe(const net::probe_result& result)
     {
-      using updater = bool(Monero::Wallet&, const std::string&);
-      const std::string_view path;
-      const std::string_view description;
-      updater* const update;
-    };
+      const std::size_t total = result.samples.size() + result.failures;
+      ftxui::Elements rows;
+      rows.push_back(
+        ftxui::text(std::to_string(result.samples.size()) + "/" + std::to_string(total) + _(" connections succeeded"))
+      );
 
-    const std::array<option, 6> options{{
-      {config::server::url,              _("API Server"),                 set_url},
-      {config::server::refresh_interval, _("Refresh Interval (seconds)"), set_refresh},
-      {config::server::ssl,              _("TLS/SSL Cert Check"),         set_ssl},
-      {config::server::proxy,            _("Proxy"),                      set_proxy},
-      {config::major_lookahead,          _("Subaddress Major Lookahead"), set_major_lookahead},
-      {config::minor_lookahead,          _("Subaddress Minor Lookahead"), set_minor_lookahead}
-    }};
+      if (!result.samples.empty())
+      {
+        const auto row = [] (const char* name, const net::percentiles& value)
+        {
+          return ftxui::Elements{
+            ftxui::text(name), ftxui::text(milliseconds(value.p50) + "  "), ftxui::text(milliseconds(value.p95))
+          };
+        };
+
+        std::vector<ftxui::Elements> grid{
+          {ftxui::text(""), ftxui::text("p50  "), ftxui::text("p95")},
+          row(_("Connect: "), result.connect)
+        };
+        if (result.tls.p95.count())
+          grid.push_back(row(_("TLS: "), result.tls));
+        grid.push_back(row(_("Request: "), result.request));
+        rows.push_back(ftxui::gridbox(std::move(grid)));
+      }
+
+      if (!result.error.empty())
+        rows.push_back(ftxui::paragraph(result.error));
+      return ftxui::vbox(std::move(rows));
+    }
 
     ftxui::Component last_input(std::string* str)
     {
@@ -141,35 +163,61 @@ namespace lwcli { namespace view
     
     struct configuration
     {
+      config::wallet_store* const saved;
+      config::wallet_store pending; //!< `saved` plus the edits, after `validate()`
       std::array<option_state, options.size()> states;
 
-      configuration(const Monero::Wallet& wal)
-        : states()
+      explicit configuration(config::wallet_store& store)
+        : saved(std::addressof(store)), pending(store), states()
       {
         for (std::size_t i = 0; i < options.size(); ++i)
         {
           states[i].description = ftxui::text(std::string{options[i].description} + ": ");
-          states[i].original = wal.getCacheAttribute(std::string{options[i].path});
+          states[i].original = store.text(options[i].path);
           states[i].value = states[i].original;
           states[i].ui = last_input(&states[i].value);
         }
       }
 
-      void store(Monero::Wallet& wal, std::string& error)
+      bool changed(const std::size_t i) const noexcept
+      { return states[i].original != states[i].value; }
+
+      /*! Parses every edited value into `pending`.
+        \return Error for the first invalid value, otherwise empty. */
+      std::string validate()
       {
+        pending = *saved;
         for (std::size_t i = 0; i < options.size(); ++i)
         {
-          if (states[i].original != states[i].value)
-          {
-            if (!options[i].update || options[i].update(wal, states[i].value))
-              wal.setCacheAttribute(std::string{options[i].path}, states[i].value);
-            else
-            {
-              error = std::string{options[i].description} + " is invalid";
-              break;
-            }
-          }
+          if (changed(i) && !pending.set_text(options[i].path, states[i].value))
+            return std::string{options[i].description} + _(" is invalid");
         }
+        return {};
+      }
+
+      //! \return True if `pending` requires a new `Wallet::init`.
+      bool needs_reconnect() const noexcept
+      {
+        using namespace config::keys;
+        return pending.any_changed<url, fallbacks, ssl, proxy>();
+      }
+
+      /*! Applies the values that do not reconnect, and then writes every
+        changed value to the cache in one batch. Call after `validate()`, and
+        after a successful `reconnect` if `needs_reconnect()`. */
+      void commit(Monero::Wallet& wal)
+      {
+        using namespace config::keys;
+        if (pending.changed<refresh_interval>())
+          wal.setAutoRefreshInterval(std::chrono::milliseconds{pending.get<refresh_interval>()}.count());
+
+        if (pending.any_changed<major_lookahead, minor_lookahead>())
+          wal.setSubaddressLookahead(pending.get<major_lookahead>(), pending.get<minor_lookahead>());
+
+        pending.store(wal);
+        *saved = pending;
+        for (option_state& state : states)
+          state.original = state.value;
       }
     };
 
@@ -186,7 +234,7 @@ namespace lwcli { namespace view
       {
         return ftxui::vbox({
           ftxui::paragraph(wal->seed()),
-          ftxui::separator(),
+          decorate::separator(),
           ftxui::gridbox({
             {ftxui::text("View Public: "), ftxui::text(wal->publicViewKey())},
             {ftxui::text("Spend Public: "), ftxui::text(wal->publicSpendKey())},
@@ -212,9 +260,9 @@ namespace lwcli { namespace view
 
       ftxui::Element OnRender() override final
       {
-        return ftxui::window(title_, ftxui::vbox({
+        return decorate::window(title_, ftxui::vbox({
           ftxui::hcenter(buttons_->Render()),
-          ftxui::separator(),
+          decorate::separator(),
           display_
         }));
       }
@@ -295,11 +343,11 @@ namespace lwcli { namespace view
       {
         ftxui::Element separator;
         if (error_.empty())
-          separator = ftxui::separator();
+          separator = decorate::separator();
         else
           separator = ftxui::text(error_) | ftxui::inverted;
 
-        return ftxui::window(title_, ftxui::vbox({
+        return decorate::window(title_, ftxui::vbox({
           ftxui::hcenter(buttons_->Render()),
           separator,
           ftxui::hbox({display_, prompt_->Render()})
@@ -310,6 +358,7 @@ namespace lwcli { namespace view
     class settings_ final : public ftxui::ComponentBase
     {
       const std::shared_ptr<Monero::Wallet> wal_;
+      const std::shared_ptr<net::failover> servers_;
       const ftxui::Element title_;
       const std::unique_ptr<configuration> config_;
       std::string error_;
@@ -317,6 +366,11 @@ namespace lwcli { namespace view
       ftxui::Component ui_;
       ftxui::Component overlay_;
       ftxui::Element cached_;
+      timer::background<std::string> applying_;
+      bool* const busy_; //!< Mirrors `applying_.valid()` for the wallet view
+      timer::background<net::probe_result> testing_;
+      ftxui::Element tested_;
+      bool saved_;
 
       bool Focusable() const override final { return true; }
       ftxui::Component ActiveChild() override final
@@ -327,25 +381,27 @@ namespace lwcli { namespace view
       }
 
     public:
-      explicit settings_(std::shared_ptr<Monero::Wallet>&& wal)
+      explicit settings_(std::shared_ptr<Monero::Wallet>&& wal, std::shared_ptr<net::failover>&& servers, config::wallet_store& store, bool* busy)
         : ftxui::ComponentBase(),
           wal_(std::move(wal)),
+          servers_(std::move(servers)),
           title_(ftxui::text(_("Settings"))),
-          config_(std::make_unique<configuration>(*wal_)),
+          config_(std::make_unique<configuration>(store)),
           error_(),
           buttons_(),
           ui_(),
           overlay_(),
-          cached_()
+          cached_(),
+          applying_(),
+          busy_(busy),
+          testing_(),
+          tested_(),
+          saved_(false)
       {
         buttons_ = ftxui::Container::Horizontal({
           ftxui::Button(_("Cancel"), [] () { throw event::close{}; }, ascii()),
-          ftxui::Button(_("Save"), [this] () {
-            error_.clear();
-            config_->store(*wal_, error_);
-            if (error_.empty())
-              throw event::close{};
-          }, ascii()),
+          ftxui::Button(_("Save"), [this] () { save(); }, ascii()),
+          ftxui::Button(_("Test"), [this] () { test(); }, ascii()),
           ftxui::Button(_("Secret Keys"), [this] () { password_prompt(); }, ascii())
         });
 
@@ -359,6 +415,47 @@ namespace lwcli { namespace view
         Add(ui_);
       }
 
+      void save()
+      {
+        if (testing_.valid())
+        {
+          error_ = _("Wait for the test to finish");
+          return;
+        }
+
+        error_ = config_->validate();
+        if (!error_.empty())
+          return;
+
+        if (!config_->needs_reconnect())
+        {
+          config_->commit(*wal_);
+          throw event::close{};
+        }
+
+        *busy_ = true;
+        applying_ = timer::async_redraw(
+          reconnect, wal_, servers_, get_connection(config_->pending), get_connection(*config_->saved)
+        );
+      }
+
+      //! Measures the entered (not saved) server and proxy
+      void test()
+      {
+        if (testing_.valid())
+          return;
+
+        error_ = config_->validate();
+        if (!error_.empty())
+          return;
+
+        const connection entered = get_connection(config_->pending);
+        tested_ = ftxui::text(_("Testing ") + entered.url + "...");
+        testing_ = timer::async_redraw(
+          net::probe, entered.url, entered.proxy, entered.ssl, config::probe_samples, config::probe_timeout
+        );
+      }
+
       void password_prompt()
       {
         overlay_ = std::make_shared<password_prompt_>(wal_, std::addressof(overlay_));
@@ -369,6 +466,13 @@ namespace lwcli { namespace view
       {
         try
         {
+          if (applying_.valid() || saved_)
+          {
+            if (saved_ && event == event::send_async)
+              throw event::close{};
+            return true; // `Wallet::init` in progress
+          }
+
           const ftxui::Component overlay = overlay_; // can detach itself
           if (overlay)
             return overlay->OnEvent(std::move(event));
@@ -379,7 +483,13 @@ namespace lwcli { namespace view
         catch (const event::close&)
         {
           if (!overlay_)
-            throw;
+          {
+            // destroying `testing_` would block the UI until the probe ends
+            if (!testing_.valid())
+              throw;
+            error_ = _("Wait for the test to finish");
+            return true;
+          }
           overlay_->Detach();
           overlay_.reset();
         }
@@ -400,26 +510,54 @@ namespace lwcli { namespace view
           grid.push_back({opt.description, min_size(opt.ui->Render())});
 
         ftxui::Element highlighted;
-        if (error_.empty())
-          highlighted = ftxui::separator();
-        else
-          highlighted = ftxui::inverted(ftxui::text(error_));
+        if (applying_.valid())
+        {
+          if (applying_.ready())
+          {
+            *busy_ = false;
+            error_ = applying_.get();
+            if (error_.empty())
+            {
+              config_->commit(*wal_);
+              saved_ = true;
+
+              ftxui::ScreenInteractive* const active = ftxui::ScreenInteractive::Active();
+              if (active)
+                active->PostEvent(event::send_async);
+            }
+          }
+          else
+            highlighted = ftxui::text(_("Connecting to ") + config_->pending.get<config::keys::url>() + "...");
+        }
+
+        if (testing_.valid() && testing_.ready())
+          tested_ = describe(testing_.get());
+
+        if (!highlighted)
+        {
+          if (error_.empty())
+            highlighted = decorate::separator();
+          else
+            highlighted = ftxui::inverted(ftxui::text(error_));
+        }
 
-        cached_ = ftxui::window(title_, ftxui::vbox({
+        cached_ = decorate::window(title_, ftxui::vbox({
           ftxui::hcenter(buttons_->Render()),
           highlighted,
-          ftxui::gridbox(std::move(grid))
+          ftxui::gridbox(std::move(grid)),
+          tested_ ? decorate::separator() : ftxui::emptyElement(),
+          tested_ ? tested_ : ftxui::emptyElement()
         }));
         return cached_;
       }
     };
   }
 
-  ftxui::Component settings(std::shared_ptr<Monero::Wallet> wal)
+  ftxui::Component settings(std::shared_ptr<Monero::Wallet> wal, std::shared_ptr<net::failover> servers, config::wallet_store* store, bool* applying)
   {
-    if (!wal)
+    if (!wal || !servers || !store || !applying)
       throw std::invalid_argument{"view::settings cannot be given nullptr"};
-    return std::make_shared<settings_>(std::move(wal));
+    return std::make_shared<settings_>(std::move(wal), std::move(servers), *store, applying);
   }
 
 }} // lwcli // 
@@ -30,9 +30,16 @@
 #include <ftxui/component/component_base.hpp>
 #include <memory>
 
+#include "wallet_config.h"
+
 namespace Monero { class Wallet; }
+namespace lwcli { namespace net { class failover; }}
 namespace lwcli { namespace view
 {
-  ftxui::Component settings(std::shared_ptr<Monero::Wallet> wallet);
+  /*! Edits `store`, the settings of the open wallet session, which must
+    outlive the component. Server changes are applied through `servers`,
+    and `*applying` is true while they run `Wallet::init`, so the caller
+    stops using `wallet` until it is false again. */
+  ftxui::Component settings(std::shared_ptr<Monero::Wallet> wallet, std::shared_ptr<net::failover> servers, config::wallet_store* store, bool* applying);
 }} // lwscli // view
 
@@ -29,20 +29,28 @@
 #include "wallet.h"
 
 #include <charconv>
+#include <functional>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/table.hpp>
 #include <lws_frontend.h>
 
+#include "cache/history.h"
 #include "decorate/overlay.h"
 #include "events.h"
 #include "lwcli_config.h"
+#include "net/failover.h"
+#include "proxy/instrument.h"
+#include "timer.h"
+#include "trace.h"
 #include "translate.h"
 #include "views/accounts.h"
+#include "views/calls.h"
 #include "views/history.h"
 #include "views/send.h"
 #include "views/settings.h"
+#include "wallet_config.h"
 
 namespace lwcli { namespace view
 {
@@ -50,24 +58,110 @@ namespace lwcli { namespace view
   {
     ftxui::ButtonOption ascii() { return ftxui::ButtonOption::Ascii(); }
 
+    //! \return Call stats overlay, or `nullptr` if `wal` is not instrumented.
+    ftxui::Component instrument(const std::shared_ptr<Monero::Wallet>& wal)
+    {
+      auto stats = proxy::find<proxy::instrument>(wal);
+      if (!stats)
+        return nullptr;
+      return calls(std::move(stats));
+    }
+
     struct wallet_state
     {
       const std::shared_ptr<Monero::WalletManager> wm;
       const std::shared_ptr<Monero::Wallet> wal;
+      config::wallet_store settings;
+      std::shared_ptr<net::failover> servers;
+      std::shared_ptr<cache::history> history_cache;
+      timer::background<std::shared_ptr<cache::history>> opening_cache;
+      timer::background<std::string> connecting; //!< Connect error, or empty
+      std::string connecting_to;
+      std::string connect_error;
       ftxui::Component overlay;
       std::uint32_t selected_account = 0;
+      bool applying = false; //!< Set by the settings view while it reconnects
+
+      //! \return False while `Wallet::init` runs, so nothing else calls the wallet.
+      bool ready() const noexcept { return !connecting.valid() && !applying; }
     };
 
+    //! Runs on a background thread; the key derivation is slow by design.
+    std::shared_ptr<cache::history> open_cache(std::string path, const std::string& password)
+    {
+      return std::make_shared<cache::history>(std::move(path), password);
+    }
+
+    /*! Runs on a background thread. Tries the primary server, then the
+      fallbacks. \return Error of the last attempt, or empty. */
+    std::string connect_wallet(const std::shared_ptr<Monero::Wallet>& wal, const std::shared_ptr<net::failover>& servers, std::vector<std::string> urls, std::string proxy, const bool ssl)
+    {
+      if (servers->connect(std::move(urls), std::move(proxy), ssl))
+        return {};
+      std::string error = LWCLI_TRACE_CALL("Wallet::errorString", wal->errorString());
+      if (error.empty())
+        error = _("Unable to connect to any server");
+      return error;
+    }
+
+    //! Runs on a background thread. \return Switch error, or empty.
+    std::string switch_wallet(const std::shared_ptr<net::failover>& servers, const std::string& url)
+    {
+      if (servers->switch_to(url))
+        return {};
+      return _("Unable to connect to ") + url;
+    }
+
+    //! \return `button` that is dimmed and ignored until `state->ready()`.
+    ftxui::Component when_ready(wallet_state* state, std::string label, std::function<void()> action)
+    {
+      auto button = ftxui::Button(
+        std::move(label),
+        [state, action = std::move(action)] () { if (state->ready()) action(); },
+        ascii()
+      );
+      return ftxui::Renderer(button, [state, button] () {
+        auto out = button->Render();
+        return state->ready() ? out : (out | ftxui::dim);
+      });
+    }
+
+    bool is_close_key(const ftxui::Event& e)
+    {
+      return e == ftxui::Event::c || e == ftxui::Event::C;
+    }
+
+    //! \return True if `e` is the shortcut of a view that needs a server.
+    bool is_online_key(const ftxui::Event& e)
+    {
+      return e == ftxui::Event::s || e == ftxui::Event::S ||
+        e == ftxui::Event::r || e == ftxui::Event::R ||
+        e == ftxui::Event::e || e == ftxui::Event::E;
+    }
+
+    //! \return True if `e` is the shortcut of a view that reads the wallet.
+    bool is_wallet_key(const ftxui::Event& e)
+    {
+      return is_online_key(e) || e == ftxui::Event::a || e == ftxui::Event::A;
+    }
+
     ftxui::Component menu_bar(wallet_state* state)
     {
       const std::shared_ptr<Monero::Wallet> wal = state->wal;
-      return ftxui::Container::Horizontal({
-        ftxui::Button("[c]lose", [] () { throw event::close{}; }, ascii()),
-        ftxui::Button("[s]end", [state] () { state->overlay = send(state->wm, state->wal, state->selected_account); }, ascii()),
-        ftxui::Button("[a]ccounts", [state] () { state->overlay = accounts(state->wal, &state->selected_account); }, ascii()),
-        ftxui::Button("[r]efresh", [wal] () { wal->refreshAsync(); }, ascii()),
-        ftxui::Button("s[e]ttings", [state] () { state->overlay = settings(state->wal); }, ascii())
-      });
+      ftxui::Components buttons{
+        when_ready(state, "[c]lose", [] () { throw event::close{}; })
+      };
+      if (!config::offline)
+        buttons.push_back(when_ready(state, "[s]end", [state] () { state->overlay = send(state->wm, state->wal, state->selected_account); }));
+      buttons.push_back(when_ready(state, "[a]ccounts", [state] () { state->overlay = accounts(state->wal, &state->selected_account); }));
+      if (!config::offline)
+      {
+        buttons.push_back(when_ready(state, "[r]efresh", [wal] () { LWCLI_TRACE_CALL("Wallet::refreshAsync", wal->refreshAsync()); }));
+        buttons.push_back(when_ready(state, "s[e]ttings", [state] () { state->overlay = settings(state->wal, state->servers, &state->settings, &state->applying); }));
+      }
+      if (proxy::find<proxy::instrument>(wal))
+        buttons.push_back(ftxui::Button("[i]nstrument", [state] () { state->overlay = instrument(state->wal); }, ascii()));
+      return ftxui::Container::Horizontal(std::move(buttons));
     }
 
     class wallet_ final : public ftxui::ComponentBase, Monero::WalletListener
@@ -78,6 +172,7 @@ namespace lwcli { namespace view
       ftxui::Component bar_;
       ftxui::Component ui_;
       ftxui::Component history_;
+      ftxui::Element history_frame_; //!< Last frame while ready, shown during later `Wallet::init`
 
       bool Focusable() const override final { return true; }
       ftxui::Component ActiveChild() override final
@@ -109,36 +204,104 @@ namespace lwcli { namespace view
           active->PostEvent(event::refresh_wallet);
       }
 
+      //! Starts the history load once `connect_wallet` or `switch_wallet` is done
+      void check_connecting()
+      {
+        if (!state_.connecting.valid() || !state_.connecting.ready())
+          return;
+
+        state_.connect_error = state_.connecting.get();
+        history_->OnEvent(event::refresh_wallet); // in place of those dropped while connecting
+      }
+
+      //! Shows the cached rows once `open_cache` is done
+      void check_cache()
+      {
+        if (!state_.opening_cache.valid() || !state_.opening_cache.ready())
+          return;
+
+        state_.history_cache = state_.opening_cache.get();
+        view::history_cache(history_, state_.history_cache);
+      }
+
+      //! Moves to the server chosen by the failover monitor, gated like the first connect
+      void check_failover()
+      {
+        if (!state_.ready() || !state_.servers || state_.overlay)
+          return;
+
+        std::string next = state_.servers->proposed();
+        if (next.empty())
+          return;
+
+        state_.connecting_to = next;
+        state_.connecting = timer::async_redraw(switch_wallet, state_.servers, std::move(next));
+      }
+
+      //! \return True if the history view must not see events or render.
+      bool history_frozen() const noexcept
+      {
+        // the first connect happens before the history view uses the wallet
+        return !state_.ready() && history_frame_;
+      }
+
     public:
-      explicit wallet_(std::shared_ptr<Monero::WalletManager>&& wm, std::shared_ptr<Monero::Wallet>&& data)
+      explicit wallet_(std::shared_ptr<Monero::WalletManager>&& wm, std::shared_ptr<Monero::Wallet>&& data, const bool connect)
         : ftxui::ComponentBase(),
           state_{std::move(wm), std::move(data)},
           title_(nullptr),
           active_account_(-1),
           bar_(),
           ui_(),
-          history_(nullptr)
+          history_(nullptr),
+          history_frame_(nullptr)
       {
         if (!state_.wal)
           throw std::runtime_error{"Unexpected nullptr Monero wallet"};
+        state_.settings = config::wallet_store{*state_.wal};
+        state_.opening_cache = timer::async_redraw(open_cache, state_.wal->path(), state_.wal->getPassword());
         state_.wal->setListener(this);
         bar_ = menu_bar(&state_);
         title_ = ftxui::text(_("lwcli Wallet (Primary ") + state_.wal->mainAddress().substr(0, 40) + "...)");
-        update_account();
+
+        // views read the wallet before `init` starts, then wait for `ready()`
+        const bool deferred = connect && !config::offline;
+        update_account(deferred);
+        if (!config::offline)
+          state_.servers = std::make_shared<net::failover>(state_.wal, state_.settings);
+        if (deferred)
+        {
+          const config::wallet_store& settings = state_.settings;
+          state_.connecting_to = settings.get<config::keys::url>();
+          state_.wal->setAutoRefreshInterval(std::chrono::milliseconds{settings.get<config::keys::refresh_interval>()}.count());
+          state_.connecting = timer::async_redraw(
+            connect_wallet,
+            state_.wal,
+            state_.servers,
+            net::endpoints(settings.get<config::keys::url>(), settings.get<config::keys::fallbacks>()),
+            settings.get<config::keys::proxy>(),
+            settings.get<config::keys::ssl>()
+          );
+        }
       }
 
       virtual ~wallet_() noexcept override final
       {
+        // close is disabled while connecting, but a lock or exit can still land here
+        state_.connecting = {}; // waits for `Wallet::init`
+        if (state_.overlay)
+          state_.overlay->Detach();
+        state_.overlay.reset();
         state_.wal->setListener(nullptr);
       }
 
-      void update_account()
+      void update_account(const bool deferred = false)
       {
         if (active_account_ != state_.selected_account)
         {
           if (ui_)
             ui_->Detach();
-          history_ = view::history(state_.wal, state_.selected_account);
+          history_ = view::history(state_.wal, state_.selected_account, state_.history_cache, deferred);
           ui_ = ftxui::Container::Vertical({bar_, history_});
           Add(ui_);
         }
@@ -147,28 +310,38 @@ namespace lwcli { namespace view
 
       bool OnEvent(ftxui::Event event) override final
       {
+        LWCLI_TRACE("wallet_::OnEvent");
+        bool handled = true;
         try
         {
           const bool has_overlay = bool(state_.overlay);
 
           if (event == event::refresh_wallet)
-            return history_->OnEvent(std::move(event));
+            return !state_.ready() || history_->OnEvent(std::move(event));
           else if (state_.overlay)
-            state_.overlay->OnEvent(std::move(event));
+            handled = state_.overlay->OnEvent(std::move(event));
           else if (event == ftxui::Event::CtrlQ)
-            return history_->OnEvent(std::move(event));
-          else if (!ui_->OnEvent(event))
+            return state_.ready() && history_->OnEvent(std::move(event));
+          else if (!(history_frozen() ? bar_ : ui_)->OnEvent(event))
           {
-            if (event == ftxui::Event::c || event == ftxui::Event::C)
+            if (config::offline && is_online_key(event))
+              handled = false;
+            else if (!state_.ready() && (is_wallet_key(event) || is_close_key(event)))
+              handled = false; // closing would wait for `Wallet::init`
+            else if (is_close_key(event))
               throw event::close{};
             else if (event == ftxui::Event::s || event == ftxui::Event::S)
               state_.overlay = send(state_.wm, state_.wal, state_.selected_account);
             else if (event == ftxui::Event::a || event == ftxui::Event::a)
               state_.overlay = accounts(state_.wal, &state_.selected_account);
             else if (event == ftxui::Event::r || event == ftxui::Event::R)
-              state_.wal->refreshAsync();
+              LWCLI_TRACE_CALL("Wallet::refreshAsync", state_.wal->refreshAsync());
             else if (event == ftxui::Event::e || event == ftxui::Event::E)
-              state_.overlay = settings(state_.wal);
+              state_.overlay = settings(state_.wal, state_.servers, &state_.settings, &state_.applying);
+            else if (event == ftxui::Event::i || event == ftxui::Event::I)
+              state_.overlay = instrument(state_.wal);
+            else
+              handled = false;
           }
 
           if (!has_overlay && state_.overlay)
@@ -184,40 +357,73 @@ namespace lwcli { namespace view
           state_.overlay.reset();
         }
 
-        return true;
+        return handled;
       }
 
       ftxui::Element OnRender() override final
       {
-        const bool connected =
-          state_.wal->connected() == Monero::Wallet::ConnectionStatus_Connected;
+        LWCLI_TRACE("wallet_::OnRender");
+        check_connecting();
+        check_failover();
+        check_cache();
+
+        // first, so settings can end `applying` before the rest checks `ready()`
+        const bool applying = state_.applying;
+        ftxui::Element overlay;
+        if (state_.overlay)
+          overlay = decorate::overlay(state_.overlay->Render());
+        if (applying && !state_.applying)
+          history_->OnEvent(event::refresh_wallet); // in place of those dropped while applying
 
-        int status = 0;
+        // no wallet calls here while `Wallet::init` runs
+        int status = Monero::Wallet::Status_Ok;
         std::string error;
-        state_.wal->statusWithErrorString(status, error);
+        if (state_.ready())
+          LWCLI_TRACE_CALL("Wallet::statusWithErrorString", state_.wal->statusWithErrorString(status, error));
 
-        std::string message = connected ? "Connected" : "Disconnected";
+        std::string message;
+        if (state_.applying)
+          message = "Applying server settings...";
+        else if (state_.connecting.valid())
+          message = "Connecting to " + state_.connecting_to + "...";
+        else if (state_.servers)
+        {
+          const bool connected =
+            LWCLI_TRACE_CALL("Wallet::connected", state_.wal->connected()) == Monero::Wallet::ConnectionStatus_Connected;
+          message = connected ? "Connected" : "Disconnected";
+          message.append(" (").append(state_.servers->active()).append(")");
+          if (!connected && !state_.connect_error.empty())
+            message.append(": ").append(state_.connect_error);
+          else if (connected)
+            state_.connect_error.clear();
+        }
+        else
+          message = "Offline (local wallet file only)";
         if (status != Monero::Wallet::Status_Ok)
           message.append(": ").append(error);
 
+        ftxui::Element history = history_frozen() ? history_frame_ : history_->Render();
+        if (state_.ready())
+          history_frame_ = history;
+
         auto screen = ftxui::vbox({
           title_,
           decorate::banner(bar_->Render()),
-          ftxui::separator(),
-          history_->Render() | ftxui::yflex_shrink,
+          decorate::separator(),
+          std::move(history) | ftxui::yflex_shrink,
           ftxui::filler(), 
           ftxui::inverted(decorate::banner(ftxui::text(std::move(message))))
         });
  
-        if (state_.overlay)
-          return ftxui::dbox({std::move(screen), decorate::overlay(state_.overlay->Render())});
+        if (overlay)
+          return ftxui::dbox({std::move(screen), std::move(overlay)});
         return screen;
       }
     };
   } // anonymous
 
-  ftxui::Component wallet(std::shared_ptr<Monero::WalletManager> wm, std::shared_ptr<Monero::Wallet> data)
+  ftxui::Component wallet(std::shared_ptr<Monero::WalletManager> wm, std::shared_ptr<Monero::Wallet> data, const bool connect)
   {
-    return std::make_shared<wallet_>(std::move(wm), std::move(data));
+    return std::make_shared<wallet_>(std::move(wm), std::move(data), connect);
   } 
 }} // lwcli // view
@@ -38,6 +38,9 @@ namespace Monero
 
 namespace lwcli { namespace view
 {
-  ftxui::Component wallet(std::shared_ptr<Monero::WalletManager> wm, std::shared_ptr<Monero::Wallet> wallet);
+  /*! Shows `wallet`. With `connect`, the wallet connects to the primary or
+    a fallback server and starts refresh in the background. Views that use the wallet are disabled until they
+    finish, so nothing calls into it concurrently with `Wallet::init`. */
+  ftxui::Component wallet(std::shared_ptr<Monero::WalletManager> wm, std::shared_ptr<Monero::Wallet> wallet, bool connect = false);
 }} // lwscli // view
 
@@ -0,0 +1,279 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "lws_frontend.h"
+#include "lwcli_config.h"
+#include "util.h"
+
+namespace lwcli { namespace config
+{
+  /*! Base of a typed wallet setting. Each key derives from this and names
+    its cache attribute, so a misspelled key or a wrong value type fails to
+    compile. */
+  template<typename T>
+  struct key
+  {
+    using type = T;
+
+    //! Used when the attribute is missing or does not parse.
+    static T fallback() { return T{}; }
+  };
+
+  namespace keys
+  {
+    struct url : key<std::string>
+    {
+      static constexpr const std::string_view name = server::url;
+    };
+
+    struct fallbacks : key<std::string>
+    {
+      static constexpr const std::string_view name = server::fallbacks;
+    };
+
+    struct proxy : key<std::string>
+    {
+      static constexpr const std::string_view name = server::proxy;
+    };
+
+    struct ssl : key<bool>
+    {
+      static constexpr const std::string_view name = server::ssl;
+    };
+
+    struct refresh_interval : key<std::chrono::seconds>
+    {
+      static constexpr const std::string_view name = server::refresh_interval;
+      static type fallback() { return server::default_refresh_interval; }
+    };
+
+    struct major_lookahead : key<std::uint32_t>
+    {
+      static constexpr const std::string_view name = config::major_lookahead;
+      static type fallback() { return default_major_lookahead; }
+    };
+
+    struct minor_lookahead : key<std::uint32_t>
+    {
+      static constexpr const std::string_view name = config::minor_lookahead;
+      static type fallback() { return default_minor_lookahead; }
+    };
+  } // keys
+
+  //! \return False if `text` is not valid for `T`; `out` is unchanged.
+  inline bool parse(const std::string_view text, std::string& out)
+  {
+    out.assign(text.data(), text.size());
+    return true;
+  }
+
+  inline bool parse(const std::string_view text, bool& out)
+  {
+    const auto value = from_string(text);
+    if (!value)
+      return false;
+    out = bool(*value);
+    return true;
+  }
+
+  inline bool parse(const std::string_view text, std::uint32_t& out)
+  {
+    const auto value = from_string(text);
+    if (!value || std::numeric_limits<std::uint32_t>::max() < *value)
+      return false;
+    out = std::uint32_t(*value);
+    return true;
+  }
+
+  inline bool parse(const std::string_view text, std::chrono::seconds& out)
+  {
+    const auto value = from_string(text);
+    if (!value || std::uint64_t(std::numeric_limits<std::chrono::seconds::rep>::max()) < *value)
+      return false;
+    out = std::chrono::seconds{*value};
+    return true;
+  }
+
+  inline std::string format(const std::string& value) { return value; }
+  inline std::string format(const bool value) { return std::to_string(int(value)); }
+  inline std::string format(const std::uint32_t value) { return std::to_string(value); }
+  inline std::string format(const std::chrono::seconds value) { return std::to_string(value.count()); }
+
+  /*! Parsed copy of the wallet settings in `K...`. Reads return references
+    into the store, and `set` only marks a key changed, so a session parses
+    its cache attributes once and writes back only what changed. Not
+    thread-safe; copy out values needed by other threads. */
+  template<typename... K>
+  class basic_store
+  {
+    static_assert(verify_sso(K::name...), "cache attribute names must fit in sso");
+
+    std::tuple<typename K::type...> values_;
+    std::bitset<sizeof...(K)> changed_;
+
+    template<typename Key, typename First, typename... Rest>
+    static constexpr std::size_t index_of() noexcept
+    {
+      if constexpr (std::is_same<Key, First>())
+        return 0;
+      else
+        return 1 + index_of<Key, Rest...>();
+    }
+
+    template<typename Key>
+    static constexpr std::size_t index() noexcept
+    { return index_of<Key, K...>(); }
+
+    template<std::size_t... I>
+    bool set_text(const std::string_view name, const std::string_view text, std::index_sequence<I...>)
+    {
+      bool found = false;
+      bool valid = false;
+      const auto one = [&] (const std::string_view this_name, auto& value, const std::size_t i)
+      {
+        if (found || this_name != name)
+          return;
+        found = true;
+        auto next = value;
+        valid = parse(text, next);
+        if (valid && next != value)
+        {
+          value = std::move(next);
+          changed_.set(i);
+        }
+      };
+      (one(K::name, std::get<I>(values_), I), ...);
+      return valid;
+    }
+
+  public:
+    //! Every key at its default
+    basic_store()
+      : values_(K::fallback()...), changed_()
+    {}
+
+    //! Reads every key from `wal`; missing or invalid attributes use defaults.
+    explicit basic_store(const Monero::Wallet& wal)
+      : basic_store()
+    {
+      load(wal, std::index_sequence_for<K...>{});
+    }
+
+    template<typename Key>
+    const typename Key::type& get() const noexcept
+    { return std::get<index<Key>()>(values_); }
+
+    template<typename Key>
+    void set(typename Key::type value)
+    {
+      auto& current = std::get<index<Key>()>(values_);
+      if (current != value)
+      {
+        current = std::move(value);
+        changed_.set(index<Key>());
+      }
+    }
+
+    //! \return True if `Key` was set to a new value since load or `store`.
+    template<typename Key>
+    bool changed() const noexcept
+    { return changed_.test(index<Key>()); }
+
+    //! \return True if any of `Keys` changed.
+    template<typename... Keys>
+    bool any_changed() const noexcept
+    { return (... || changed<Keys>()); }
+
+    //! \return Value of the key stored as `name`, formatted for editing.
+    std::string text(const std::string_view name) const
+    {
+      std::string out;
+      std::apply([&] (const auto&... values) {
+        ((K::name == name ? void(out = format(values)) : void()), ...);
+      }, values_);
+      return out;
+    }
+
+    //! Parses `text` into the key stored as `name`. \return False if invalid or unknown.
+    bool set_text(const std::string_view name, const std::string_view text)
+    { return set_text(name, text, std::index_sequence_for<K...>{}); }
+
+    //! Writes every changed key to `wal` in one pass, then clears the changes.
+    void store(Monero::Wallet& wal)
+    {
+      store(wal, std::index_sequence_for<K...>{});
+      changed_.reset();
+    }
+
+  private:
+    template<std::size_t... I>
+    void load(const Monero::Wallet& wal, std::index_sequence<I...>)
+    {
+      (parse(wal.getCacheAttribute(std::string{K::name}), std::get<I>(values_)), ...);
+    }
+
+    template<std::size_t... I>
+    void store(Monero::Wallet& wal, std::index_sequence<I...>)
+    {
+      ((changed_.test(I) ? void(wal.setCacheAttribute(std::string{K::name}, format(std::get<I>(values_)))) : void()), ...);
+    }
+  };
+
+  using wallet_store = basic_store<
+    keys::url,
+    keys::fallbacks,
+    keys::refresh_interval,
+    keys::ssl,
+    keys::proxy,
+    keys::major_lookahead,
+    keys::minor_lookahead
+  >;
+
+  //! \return Settings for new wallets when no profile changes them.
+  inline wallet_store builtin_profile()
+  {
+    wallet_store out;
+    out.set<keys::url>(std::string{server::default_url});
+    return out;
+  }
+
+  //! Settings for new wallets. Replaced at startup by the `--profile` section.
+  inline wallet_store profile = builtin_profile();
+}} // lwcli // config
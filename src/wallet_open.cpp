@@ -0,0 +1,86 @@
+// Copyright (c) 2025, Cifro Codes LLC
+// 
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+// 
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "wallet_open.h"
+
+#include <chrono>
+#include <lws_frontend.h>
+#include <stdexcept>
+
+#include "lwcli_config.h"
+#include "trace.h"
+#include "wallet_config.h"
+
+namespace lwcli
+{
+  void close_wallet::operator()(Monero::Wallet* ptr) const
+  {
+    if (ptr)
+      wm->closeWallet(ptr, true /* store */);
+  }
+
+  std::shared_ptr<Monero::Wallet> prep_wallet(std::shared_ptr<Monero::WalletManager> wm, Monero::Wallet* ptr, std::string* error)
+  {
+    std::unique_ptr<Monero::Wallet> data{ptr};
+    if (!data)
+      throw std::runtime_error{"unexpected wallet nullptr"};
+    if (!error)
+      throw std::invalid_argument{"lwcli::prep_wallet given nullptr"};
+
+    int status = 0;
+    error->clear();
+    data->statusWithErrorString(status, *error);
+    if (status != Monero::Wallet::Status_Ok)
+      return nullptr;
+
+    return {data.release(), close_wallet{std::move(wm)}};
+  }
+
+  bool init_wallet(Monero::Wallet& wal, std::string* error)
+  {
+    if (config::offline)
+      return true;
+
+    const config::wallet_store settings{wal};
+    wal.setAutoRefreshInterval(std::chrono::milliseconds{settings.get<config::keys::refresh_interval>()}.count());
+
+    const bool connected = LWCLI_TRACE_CALL("Wallet::init", wal.init(
+      settings.get<config::keys::url>(),
+      0, "", "",
+      settings.get<config::keys::ssl>(),
+      true,
+      settings.get<config::keys::proxy>()
+    ));
+    if (!connected)
+    {
+      *error = "Failure to initialize" + wal.errorString();
+      return false;
+    }
+    return true;
+  }
+} // lwcli